@@ -0,0 +1,250 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Callbacks/SteamCallResults.h"
+
+#include "Globals.h"
+#include "Callbacks/SteamCallbackRouter.h"
+#include "steam/steam_api.h"
+
+#include <atomic>
+
+/**
+ * Call result registration of a pending call slot, completed by SteamAPI_RunCallbacks when manual dispatch is disabled.
+ * Reused by every call the slot holds, Steam forgets the registration on its own once the result was delivered.
+ * Registering and unregistering take Steam's own lock, so it happens outside of FSteamCallResults::Mutex, serialized by RegisterLock.
+ */
+class FSteamCallResultBridge : public CCallbackBase
+{
+public:
+	explicit FSteamCallResultBridge(FSteamCallResults& InOwner) : Owner(InOwner) {}
+
+	virtual ~FSteamCallResultBridge()
+	{
+		Unregister(Call);
+	}
+
+	void Register(const uint64 NewCall, const int32 CallbackId, const int32 InResultSize)
+	{
+		FScopeLock Lock(&RegisterLock);
+
+		//a slot may be reused before the previous call was unregistered
+		const uint64 PreviousCall = Call.exchange(k_uAPICallInvalid);
+		if (PreviousCall != k_uAPICallInvalid)
+		{
+			SteamAPI_UnregisterCallResult(this, PreviousCall);
+		}
+
+		ResultSize = InResultSize;
+		m_iCallback = CallbackId;
+		Call = NewCall;
+		SteamAPI_RegisterCallResult(this, NewCall);
+	}
+
+	/// Drop the registration if it still belongs to ExpectedCall
+	void Unregister(const uint64 ExpectedCall)
+	{
+		FScopeLock Lock(&RegisterLock);
+
+		uint64 Expected = ExpectedCall;
+		if (ExpectedCall != k_uAPICallInvalid && Call.compare_exchange_strong(Expected, k_uAPICallInvalid))
+		{
+			SteamAPI_UnregisterCallResult(this, ExpectedCall);
+		}
+	}
+
+	virtual void Run(void* pvParam) override
+	{
+		Run(pvParam, false, Call);
+	}
+
+	virtual void Run(void* pvParam, const bool bIOFailure, const SteamAPICall_t hSteamAPICall) override
+	{
+		//Steam dropped the registration before calling, and may hold its own lock here so RegisterLock is off limits
+		uint64 Expected = hSteamAPICall;
+		Call.compare_exchange_strong(Expected, k_uAPICallInvalid);
+		Owner.OnCallResult(hSteamAPICall, pvParam, bIOFailure);
+	}
+
+	virtual int GetCallbackSizeBytes() override
+	{
+		return ResultSize;
+	}
+
+private:
+	FSteamCallResults& Owner;
+	FCriticalSection RegisterLock;
+	std::atomic<uint64> Call{k_uAPICallInvalid};
+	int32 ResultSize = 0;
+};
+
+FSteamCallResults::FSteamCallResults()
+{
+	Slots.Reserve(32);
+	FreeSlots.Reserve(32);
+	SlotByCall.Reserve(32);
+}
+
+FSteamCallResults::~FSteamCallResults()
+{
+	//fail everything that is still pending so nobody waits on a future forever
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		FPendingCall PendingCall;
+		if (TakePendingCall(SlotIndex, PendingCall))
+		{
+			FinishPendingCall(PendingCall, nullptr, true);
+		}
+	}
+}
+
+void FSteamCallResults::Cancel(const uint64 Call)
+{
+	FPendingCall PendingCall;
+	bool bFound = false;
+	{
+		FScopeLock Lock(&Mutex);
+		if (const int32* SlotIndex = SlotByCall.Find(Call))
+		{
+			bFound = TakePendingCall(*SlotIndex, PendingCall);
+		}
+	}
+
+	if (bFound)
+	{
+		FinishPendingCall(PendingCall, nullptr, true);
+	}
+}
+
+int32 FSteamCallResults::GetNumPending() const
+{
+	FScopeLock Lock(&Mutex);
+	return SlotByCall.Num();
+}
+
+void FSteamCallResults::Initialize(FSteamCallbackRouter& Router)
+{
+	FScopeLock Lock(&Mutex);
+
+	bManualDispatch = Router.IsManualDispatch();
+	if (bManualDispatch)
+	{
+		Router.Register<SteamAPICallCompleted_t>([this](const SteamAPICallCompleted_t& Completed) {OnCallCompleted(Completed);}, ESteamCallbackThread::AnyThread);
+	}
+}
+
+void FSteamCallResults::AddPendingCall(FPendingCall&& PendingCall)
+{
+	if (PendingCall.Call == 0)
+	{
+		PendingCall.Complete(nullptr, true);
+		return;
+	}
+
+	const uint64 Call = PendingCall.Call;
+	const int32 CallbackId = PendingCall.CallbackId;
+	const int32 ResultSize = PendingCall.ResultSize;
+	FSteamCallResultBridge* Bridge = nullptr;
+	{
+		FScopeLock Lock(&Mutex);
+
+		int32 SlotIndex;
+		if (FreeSlots.Num() > 0)
+		{
+			SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+		}
+		else
+		{
+			SlotIndex = Slots.AddDefaulted();
+			Bridges.Add(MakeUnique<FSteamCallResultBridge>(*this));
+		}
+
+		Bridge = bManualDispatch ? nullptr : Bridges[SlotIndex].Get();
+		PendingCall.Bridge = Bridge;
+		SlotByCall.Add(Call, SlotIndex);
+		Slots[SlotIndex] = MoveTemp(PendingCall);
+	}
+
+	//results are only delivered by the pump, registering after the slot is visible can not miss one
+	if (Bridge)
+	{
+		Bridge->Register(Call, CallbackId, ResultSize);
+	}
+}
+
+bool FSteamCallResults::TakePendingCall(const int32 SlotIndex, FPendingCall& OutPendingCall)
+{
+	FScopeLock Lock(&Mutex);
+
+	FPendingCall& Slot = Slots[SlotIndex];
+	if (Slot.Call == 0)
+	{
+		return false;
+	}
+
+	//the promise moves along with the call, the slot is free again afterwards
+	SlotByCall.Remove(Slot.Call);
+	OutPendingCall = MoveTemp(Slot);
+	Slot.Call = 0;
+	FreeSlots.Add(SlotIndex);
+	return true;
+}
+
+void FSteamCallResults::OnCallCompleted(const SteamAPICallCompleted_t& Completed)
+{
+	FPendingCall PendingCall;
+	bool bFetched = false;
+	bool bFailed = true;
+	{
+		FScopeLock Lock(&Mutex);
+
+		const int32* SlotIndex = SlotByCall.Find(Completed.m_hAsyncCall);
+		if (!SlotIndex)
+		{
+			return;
+		}
+
+		const FPendingCall& Slot = Slots[*SlotIndex];
+		if (Slot.CallbackId == Completed.m_iCallback && static_cast<int32>(Completed.m_cubParam) >= Slot.ResultSize)
+		{
+			ResultBuffer.SetNumUninitialized(Completed.m_cubParam, EAllowShrinking::No);
+			bFetched = SteamAPI_ManualDispatch_GetAPICallResult(SteamAPI_GetHSteamPipe(), Completed.m_hAsyncCall, ResultBuffer.GetData(),
+				Completed.m_cubParam, Completed.m_iCallback, &bFailed);
+		}
+		else
+		{
+			UE_LOG(SteamCoreLog, Error, TEXT("Call result %llu completed as callback %d, awaited as %d"), Completed.m_hAsyncCall, Completed.m_iCallback, Slot.CallbackId);
+		}
+
+		TakePendingCall(*SlotIndex, PendingCall);
+	}
+
+	//complete outside of the lock, continuations are free to await new calls
+	FinishPendingCall(PendingCall, bFetched ? ResultBuffer.GetData() : nullptr, bFailed);
+}
+
+void FSteamCallResults::OnCallResult(const uint64 Call, const void* Data, const bool bIOFailure)
+{
+	FPendingCall PendingCall;
+	{
+		FScopeLock Lock(&Mutex);
+
+		const int32* SlotIndex = SlotByCall.Find(Call);
+		if (!SlotIndex || !TakePendingCall(*SlotIndex, PendingCall))
+		{
+			return;
+		}
+	}
+
+	//Steam owns Data until Run returns, the promise copies it right away
+	FinishPendingCall(PendingCall, bIOFailure ? nullptr : Data, bIOFailure);
+}
+
+void FSteamCallResults::FinishPendingCall(FPendingCall& PendingCall, const void* Data, const bool bIOFailure)
+{
+	if (PendingCall.Bridge)
+	{
+		PendingCall.Bridge->Unregister(PendingCall.Call);
+	}
+
+	PendingCall.Complete(Data, bIOFailure);
+}
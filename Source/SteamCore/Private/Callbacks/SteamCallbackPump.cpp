@@ -0,0 +1,49 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Callbacks/SteamCallbackPump.h"
+
+#include "Globals.h"
+#include "HAL/RunnableThread.h"
+
+FSteamCallbackPump::FSteamCallbackPump(const double InPumpRate, TFunction<void()> InPumpFunction)
+	: PumpPeriod(1.0 / FMath::Max(InPumpRate, 1.0))
+	, PumpFunction(MoveTemp(InPumpFunction))
+{
+	Thread = FRunnableThread::Create(this, TEXT("SteamCallbackPump"), 0, TPri_Normal);
+
+	UE_LOG(SteamCoreLog, Log, TEXT("Steam callbacks are pumped on a worker thread at %.1f Hz"), 1.0 / PumpPeriod);
+}
+
+FSteamCallbackPump::~FSteamCallbackPump()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+uint32 FSteamCallbackPump::Run()
+{
+	while (!bStopping)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		PumpFunction();
+
+		//a slow pump simply runs late, there is no point in catching up on missed pumps
+		const double Remaining = PumpPeriod - (FPlatformTime::Seconds() - StartTime);
+		if (Remaining > 0.0)
+		{
+			FPlatformProcess::SleepNoStats(static_cast<float>(Remaining));
+		}
+	}
+
+	return 0;
+}
+
+void FSteamCallbackPump::Stop()
+{
+	bStopping = true;
+}
@@ -0,0 +1,35 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+
+class FRunnableThread;
+
+/**
+ * Pumps Steam callbacks on a dedicated thread so a slow Steam client (overlay, cloud sync) never stalls the game thread.
+ * Handlers that need the game thread are queued by the FSteamCallbackRouter and flushed from the core ticker.
+ */
+class FSteamCallbackPump : public FRunnable
+{
+public:
+	/// @param InPumpRate Rate in Hz at which callbacks get pumped
+	/// @param InPumpFunction Function pumping the callbacks, called on the pump thread
+	FSteamCallbackPump(double InPumpRate, TFunction<void()> InPumpFunction);
+	virtual ~FSteamCallbackPump() override;
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	double PumpPeriod;
+	TFunction<void()> PumpFunction;
+
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{false};
+};
@@ -0,0 +1,283 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Callbacks/SteamCallbackRouter.h"
+
+#include "Globals.h"
+#include "steam/steam_api.h"
+
+/**
+ * Forwards a callback from the SDK registry into the router, used when manual dispatch is disabled.
+ */
+class FSteamCallbackBridge : public CCallbackBase
+{
+public:
+	FSteamCallbackBridge(FSteamCallbackRouter& InRouter, const int32 InCallbackId, const int32 InCallbackSize) : Router(InRouter), CallbackSize(InCallbackSize)
+	{
+		SteamAPI_RegisterCallback(this, InCallbackId);
+	}
+
+	virtual ~FSteamCallbackBridge()
+	{
+		if (m_nCallbackFlags & k_ECallbackFlagsRegistered)
+		{
+			SteamAPI_UnregisterCallback(this);
+		}
+	}
+
+	virtual void Run(void* pvParam) override
+	{
+		Router.Dispatch(m_iCallback, pvParam, CallbackSize);
+	}
+
+	virtual void Run(void* pvParam, bool bIOFailure, SteamAPICall_t hSteamAPICall) override
+	{
+		Run(pvParam);
+	}
+
+	virtual int GetCallbackSizeBytes() override
+	{
+		return CallbackSize;
+	}
+
+private:
+	FSteamCallbackRouter& Router;
+	int32 CallbackSize;
+};
+
+FSteamCallbackRouter::FSteamCallbackRouter() = default;
+
+FSteamCallbackRouter::~FSteamCallbackRouter()
+{
+	FScopeLock Lock(&Mutex);
+	Slots.Empty();
+	SlotIndexById.Empty();
+}
+
+FSteamCallbackHandle FSteamCallbackRouter::RegisterRaw(const int32 CallbackId, const int32 CallbackSize, TFunction<void(const void*)> Handler,
+	const ESteamCallbackThread Thread)
+{
+	if (CallbackId < 0 || !Handler)
+	{
+		return {};
+	}
+
+	FHandler NewHandler{0, Thread, MakeShared<const TFunction<void(const void*)>, ESPMode::ThreadSafe>(MoveTemp(Handler))};
+
+	FScopeLock Lock(&Mutex);
+
+	NewHandler.HandlerId = NextHandlerId++;
+	const FSteamCallbackHandle Handle{CallbackId, NewHandler.HandlerId};
+
+	//dispatches work on copies of the handler list, adding right away never disturbs a running handler
+	AddHandler(CallbackId, CallbackSize, MoveTemp(NewHandler));
+	return Handle;
+}
+
+void FSteamCallbackRouter::Unregister(FSteamCallbackHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&Mutex);
+
+	if (SlotIndexById.IsValidIndex(Handle.CallbackId) && SlotIndexById[Handle.CallbackId] != INDEX_NONE)
+	{
+		FSlot& Slot = Slots[SlotIndexById[Handle.CallbackId]];
+		const int32 HandlerIndex = Slot.Handlers.IndexOfByPredicate([&Handle](const FHandler& Handler) {return Handler.HandlerId == Handle.HandlerId;});
+		if (HandlerIndex != INDEX_NONE)
+		{
+			Slot.NumGameThreadHandlers -= Slot.Handlers[HandlerIndex].Thread == ESteamCallbackThread::GameThread ? 1 : 0;
+			Slot.Handlers.RemoveAt(HandlerIndex);
+		}
+	}
+
+	Handle = {};
+}
+
+bool FSteamCallbackRouter::Dispatch(const int32 CallbackId, const void* Data, const int32 DataSize)
+{
+	const bool bIsGameThread = IsInGameThread();
+
+	FHandlerList Handlers;
+	{
+		FScopeLock Lock(&Mutex);
+
+		const int32 SlotIndex = SlotIndexById.IsValidIndex(CallbackId) ? SlotIndexById[CallbackId] : INDEX_NONE;
+		if (SlotIndex == INDEX_NONE)
+		{
+			++UnhandledCount;
+			return false;
+		}
+
+		if (DataSize < Slots[SlotIndex].CallbackSize)
+		{
+			UE_LOG(SteamCoreLog, Error, TEXT("Callback %d delivered with %d bytes, handlers expect %d"), CallbackId, DataSize, Slots[SlotIndex].CallbackSize);
+			return false;
+		}
+
+		if (!bIsGameThread && Slots[SlotIndex].NumGameThreadHandlers > 0)
+		{
+			QueueForGameThread(CallbackId, Data, DataSize);
+		}
+
+		CollectHandlers(SlotIndex, bIsGameThread, true, Handlers);
+	}
+
+	InvokeHandlers(CallbackId, Handlers, Data, true);
+	return true;
+}
+
+void FSteamCallbackRouter::FlushGameThreadCallbacks()
+{
+	check(IsInGameThread());
+
+	{
+		FScopeLock QueueLock(&QueueMutex);
+		Swap(QueuedCallbacks, FlushingCallbacks);
+		Swap(QueuedData, FlushingData);
+	}
+
+	if (FlushingCallbacks.Num() == 0)
+	{
+		return;
+	}
+
+	FHandlerList Handlers;
+	for (const FQueuedCallback& Queued : FlushingCallbacks)
+	{
+		Handlers.Reset();
+		{
+			FScopeLock Lock(&Mutex);
+			const int32 SlotIndex = SlotIndexById.IsValidIndex(Queued.CallbackId) ? SlotIndexById[Queued.CallbackId] : INDEX_NONE;
+			if (SlotIndex != INDEX_NONE)
+			{
+				CollectHandlers(SlotIndex, true, false, Handlers);
+			}
+		}
+
+		InvokeHandlers(Queued.CallbackId, Handlers, FlushingData.GetData() + Queued.Offset, false);
+	}
+
+	FlushingCallbacks.Reset();
+	FlushingData.Reset();
+}
+
+void FSteamCallbackRouter::SetManualDispatch(const bool bInManualDispatch)
+{
+	FScopeLock Lock(&Mutex);
+
+	if (!ensureMsgf(Slots.Num() == 0, TEXT("The callback dispatch mode can only be changed before handlers are registered")))
+	{
+		return;
+	}
+
+	bManualDispatch = bInManualDispatch;
+}
+
+void FSteamCallbackRouter::GetStats(TArray<FSteamCallbackStats>& OutStats) const
+{
+	FScopeLock Lock(&Mutex);
+
+	OutStats.Reset(Slots.Num());
+	for (const FSlot& Slot : Slots)
+	{
+		OutStats.Add(Slot.Stats);
+	}
+}
+
+void FSteamCallbackRouter::ResetStats()
+{
+	FScopeLock Lock(&Mutex);
+
+	for (FSlot& Slot : Slots)
+	{
+		Slot.Stats = FSteamCallbackStats();
+		Slot.Stats.CallbackId = Slot.CallbackId;
+	}
+	UnhandledCount = 0;
+}
+
+void FSteamCallbackRouter::AddHandler(const int32 CallbackId, const int32 CallbackSize, FHandler&& NewHandler)
+{
+	if (!SlotIndexById.IsValidIndex(CallbackId))
+	{
+		const int32 OldNum = SlotIndexById.Num();
+		SlotIndexById.SetNumUninitialized(CallbackId + 1);
+		for (int32 Index = OldNum; Index < SlotIndexById.Num(); ++Index)
+		{
+			SlotIndexById[Index] = INDEX_NONE;
+		}
+	}
+
+	if (SlotIndexById[CallbackId] == INDEX_NONE)
+	{
+		SlotIndexById[CallbackId] = Slots.AddDefaulted();
+
+		FSlot& NewSlot = Slots[SlotIndexById[CallbackId]];
+		NewSlot.CallbackId = CallbackId;
+		NewSlot.CallbackSize = CallbackSize;
+		NewSlot.Stats.CallbackId = CallbackId;
+
+		if (!bManualDispatch)
+		{
+			NewSlot.Bridge = MakeUnique<FSteamCallbackBridge>(*this, CallbackId, CallbackSize);
+		}
+	}
+
+	FSlot& Slot = Slots[SlotIndexById[CallbackId]];
+	if (Slot.CallbackSize != CallbackSize)
+	{
+		UE_LOG(SteamCoreLog, Warning, TEXT("Callback %d registered with size %d, previously registered with size %d"), CallbackId, CallbackSize, Slot.CallbackSize);
+	}
+
+	if (NewHandler.Thread == ESteamCallbackThread::GameThread)
+	{
+		++Slot.NumGameThreadHandlers;
+	}
+
+	Slot.Handlers.Add(MoveTemp(NewHandler));
+}
+
+void FSteamCallbackRouter::CollectHandlers(const int32 SlotIndex, const bool bGameThreadHandlers, const bool bAnyThreadHandlers, FHandlerList& OutHandlers) const
+{
+	for (const FHandler& Handler : Slots[SlotIndex].Handlers)
+	{
+		if (Handler.Thread == ESteamCallbackThread::GameThread ? bGameThreadHandlers : bAnyThreadHandlers)
+		{
+			OutHandlers.Add(Handler.Function);
+		}
+	}
+}
+
+void FSteamCallbackRouter::InvokeHandlers(const int32 CallbackId, const FHandlerList& Handlers, const void* Data, const bool bCount)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (const TSharedPtr<const TFunction<void(const void*)>, ESPMode::ThreadSafe>& Handler : Handlers)
+	{
+		(*Handler)(Data);
+	}
+
+	const double Duration = FPlatformTime::Seconds() - StartTime;
+
+	//slots are never removed, the index is still valid even if handlers registered meanwhile
+	FScopeLock Lock(&Mutex);
+	FSteamCallbackStats& Stats = Slots[SlotIndexById[CallbackId]].Stats;
+	Stats.Count += bCount ? 1 : 0;
+	Stats.TotalSeconds += Duration;
+	Stats.MaxSeconds = FMath::Max(Stats.MaxSeconds, Duration);
+}
+
+void FSteamCallbackRouter::QueueForGameThread(const int32 CallbackId, const void* Data, const int32 DataSize)
+{
+	FScopeLock QueueLock(&QueueMutex);
+
+	//keep every payload 16 byte aligned so handlers can read the callback struct in place
+	const int32 Offset = Align(QueuedData.Num(), 16);
+	QueuedData.SetNumUninitialized(Offset + DataSize, EAllowShrinking::No);
+	FMemory::Memcpy(QueuedData.GetData() + Offset, Data, DataSize);
+
+	QueuedCallbacks.Add({CallbackId, Offset, DataSize});
+}
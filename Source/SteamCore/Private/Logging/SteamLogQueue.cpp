@@ -0,0 +1,90 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Logging/SteamLogQueue.h"
+
+#include "Globals.h"
+
+FSteamLogQueue::FSteamLogQueue()
+{
+	for (int32 Index = 0; Index < Capacity; ++Index)
+	{
+		Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+	}
+}
+
+FSteamLogQueue& FSteamLogQueue::Get()
+{
+	static FSteamLogQueue Queue;
+	return Queue;
+}
+
+bool FSteamLogQueue::Push(const int32 Severity, const ANSICHAR* Text)
+{
+	uint64 Position = EnqueuePosition.load(std::memory_order_relaxed);
+	FSlot* Slot;
+
+	for (;;)
+	{
+		Slot = &Slots[Position & (Capacity - 1)];
+		const uint64 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+		const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Position);
+
+		if (Difference == 0)
+		{
+			if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (Difference < 0)
+		{
+			//the consumer has not freed this slot yet, the queue is full
+			DroppedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			Position = EnqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	Slot->Severity = Severity;
+	FCStringAnsi::Strncpy(Slot->Text, Text ? Text : "", MaxMessageLength);
+	Slot->Sequence.store(Position + 1, std::memory_order_release);
+	return true;
+}
+
+void FSteamLogQueue::Drain()
+{
+	for (;;)
+	{
+		FSlot& Slot = Slots[DequeuePosition & (Capacity - 1)];
+		if (Slot.Sequence.load(std::memory_order_acquire) != DequeuePosition + 1)
+		{
+			break;
+		}
+
+		switch (Slot.Severity)
+		{
+		case 0:
+			UE_LOG(SteamCoreLog, Log, TEXT("%hs"), Slot.Text);
+			break;
+		case 1:
+			UE_LOG(SteamCoreLog, Warning, TEXT("%hs"), Slot.Text);
+			break;
+		default:
+			UE_LOG(SteamCoreLog, Error, TEXT("%hs"), Slot.Text);
+			break;
+		}
+
+		Slot.Sequence.store(DequeuePosition + Capacity, std::memory_order_release);
+		++DequeuePosition;
+	}
+
+	const uint64 Dropped = DroppedCount.load(std::memory_order_relaxed);
+	if (Dropped != ReportedDroppedCount)
+	{
+		UE_LOG(SteamCoreLog, Warning, TEXT("Dropped %llu Steam log messages, the log queue was full (%llu dropped in total)"), Dropped - ReportedDroppedCount, Dropped);
+		ReportedDroppedCount = Dropped;
+	}
+}
@@ -0,0 +1,51 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Bounded, lock free queue for messages of the Steam warning hook.
+ * Any thread can push, messages are formatted and logged when the game thread drains the queue at the end of the frame.
+ * When the queue is full messages are dropped and counted instead of blocking the thread Steam called the hook on.
+ */
+class FSteamLogQueue
+{
+public:
+	static constexpr int32 Capacity = 256;
+	static constexpr int32 MaxMessageLength = 512;
+
+	FSteamLogQueue();
+
+	static FSteamLogQueue& Get();
+
+	/// Copy a message into the queue, safe to call from any thread
+	/// @return false if the queue was full and the message got dropped
+	bool Push(int32 Severity, const ANSICHAR* Text);
+
+	/// Log every queued message, must only be called from a single thread at a time
+	void Drain();
+
+	/** Total amount of messages dropped because the queue was full */
+	uint64 GetDroppedCount() const {return DroppedCount.load(std::memory_order_relaxed);}
+
+private:
+	struct FSlot
+	{
+		/** Position the slot is ready for, used to hand the slot back and forth between producers and the consumer */
+		std::atomic<uint64> Sequence{0};
+		int32 Severity = 0;
+		ANSICHAR Text[MaxMessageLength];
+	};
+
+	static_assert(FMath::IsPowerOfTwo(Capacity), "Capacity must be a power of two");
+
+	FSlot Slots[Capacity];
+	std::atomic<uint64> EnqueuePosition{0};
+	uint64 DequeuePosition = 0;
+
+	std::atomic<uint64> DroppedCount{0};
+	uint64 ReportedDroppedCount = 0;
+};
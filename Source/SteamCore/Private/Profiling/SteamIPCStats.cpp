@@ -0,0 +1,128 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Profiling/SteamIPCStats.h"
+
+#include "Globals.h"
+#include "steam/steam_api.h"
+#include "steam/isteamutils.h"
+
+CSV_DEFINE_CATEGORY_MODULE(STEAMCORE_API, SteamIPC, true);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Steam Client IPC Calls"), STAT_SteamIPC_ClientCalls, STATGROUP_SteamIPC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Core Calls"), STAT_SteamIPC_CoreCalls, STATGROUP_SteamIPC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Calls"), STAT_SteamIPC_InputCalls, STATGROUP_SteamIPC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Glyph Calls"), STAT_SteamIPC_GlyphsCalls, STATGROUP_SteamIPC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Haptics Calls"), STAT_SteamIPC_HapticsCalls, STATGROUP_SteamIPC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debug Calls"), STAT_SteamIPC_DebugCalls, STATGROUP_SteamIPC);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Core Time (ms)"), STAT_SteamIPC_CoreTime, STATGROUP_SteamIPC);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Input Time (ms)"), STAT_SteamIPC_InputTime, STATGROUP_SteamIPC);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Glyph Time (ms)"), STAT_SteamIPC_GlyphsTime, STATGROUP_SteamIPC);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Haptics Time (ms)"), STAT_SteamIPC_HapticsTime, STATGROUP_SteamIPC);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Debug Time (ms)"), STAT_SteamIPC_DebugTime, STATGROUP_SteamIPC);
+
+FSteamIPCStats& FSteamIPCStats::Get()
+{
+	static FSteamIPCStats Stats;
+	return Stats;
+}
+
+int32 FSteamIPCStats::RegisterCallSite(const TCHAR* MethodName, const ESteamIPCSubsystem Subsystem)
+{
+	FScopeLock Lock(&RegisterMutex);
+
+	const int32 Num = NumEntries.load(std::memory_order_relaxed);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (Entries[Index].Subsystem == Subsystem && FCString::Strcmp(Entries[Index].MethodName, MethodName) == 0)
+		{
+			return Index;
+		}
+	}
+
+	if (Num == MaxEntries)
+	{
+		UE_LOG(SteamCoreLog, Warning, TEXT("Steam IPC stats table is full, calls to %s are not counted"), MethodName);
+		return INDEX_NONE;
+	}
+
+	FEntry& Entry = Entries[Num];
+	Entry.MethodName = MethodName;
+	Entry.Subsystem = Subsystem;
+	Entry.CsvStatName = FName(FString::Printf(TEXT("%s/%s"), GetSubsystemName(Subsystem), MethodName));
+
+	NumEntries.store(Num + 1, std::memory_order_release);
+	return Num;
+}
+
+void FSteamIPCStats::EndFrame()
+{
+	uint32 SubsystemCalls[static_cast<int32>(ESteamIPCSubsystem::Num)] = {};
+	uint64 SubsystemCycles[static_cast<int32>(ESteamIPCSubsystem::Num)] = {};
+
+	const int32 Num = NumEntries.load(std::memory_order_acquire);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		FEntry& Entry = Entries[Index];
+		const uint32 Calls = Entry.FrameCalls.exchange(0, std::memory_order_relaxed);
+		const uint64 Cycles = Entry.FrameCycles.exchange(0, std::memory_order_relaxed);
+
+		Entry.TotalCalls += Calls;
+		Entry.TotalCycles += Cycles;
+		SubsystemCalls[static_cast<int32>(Entry.Subsystem)] += Calls;
+		SubsystemCycles[static_cast<int32>(Entry.Subsystem)] += Cycles;
+
+#if CSV_PROFILER
+		FCsvProfiler::RecordCustomStat(Entry.CsvStatName, CSV_CATEGORY_INDEX(SteamIPC), static_cast<int32>(Calls), ECsvCustomStatOp::Set);
+#endif
+	}
+
+	//calls made by the whole process since the previous query, including the ones outside of this plugin
+	const uint32 ClientCalls = SteamUtils() ? SteamUtils()->GetIPCCallCount() : 0;
+	SET_DWORD_STAT(STAT_SteamIPC_ClientCalls, ClientCalls);
+	CSV_CUSTOM_STAT(SteamIPC, ClientCalls, static_cast<int32>(ClientCalls), ECsvCustomStatOp::Set);
+
+#define SET_SUBSYSTEM_STATS(Subsystem) \
+	SET_DWORD_STAT(STAT_SteamIPC_##Subsystem##Calls, SubsystemCalls[static_cast<int32>(ESteamIPCSubsystem::Subsystem)]); \
+	SET_FLOAT_STAT(STAT_SteamIPC_##Subsystem##Time, FPlatformTime::ToMilliseconds64(SubsystemCycles[static_cast<int32>(ESteamIPCSubsystem::Subsystem)]));
+
+	SET_SUBSYSTEM_STATS(Core)
+	SET_SUBSYSTEM_STATS(Input)
+	SET_SUBSYSTEM_STATS(Glyphs)
+	SET_SUBSYSTEM_STATS(Haptics)
+	SET_SUBSYSTEM_STATS(Debug)
+
+#undef SET_SUBSYSTEM_STATS
+}
+
+void FSteamIPCStats::DumpTotals() const
+{
+	const int32 Num = NumEntries.load(std::memory_order_acquire);
+
+	UE_LOG(SteamCoreLog, Log, TEXT("Steam IPC calls by method:"));
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Entry.TotalCycles);
+		UE_LOG(SteamCoreLog, Log, TEXT("  %-8s %-40s %10llu calls, %10.3f ms total, %.4f ms average"), GetSubsystemName(Entry.Subsystem), Entry.MethodName,
+			Entry.TotalCalls, TotalMs, Entry.TotalCalls > 0 ? TotalMs / Entry.TotalCalls : 0.0);
+	}
+}
+
+const TCHAR* FSteamIPCStats::GetSubsystemName(const ESteamIPCSubsystem Subsystem)
+{
+	switch (Subsystem)
+	{
+	case ESteamIPCSubsystem::Core:
+		return TEXT("Core");
+	case ESteamIPCSubsystem::Input:
+		return TEXT("Input");
+	case ESteamIPCSubsystem::Glyphs:
+		return TEXT("Glyphs");
+	case ESteamIPCSubsystem::Haptics:
+		return TEXT("Haptics");
+	case ESteamIPCSubsystem::Debug:
+		return TEXT("Debug");
+	default:
+		return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,7 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Profiling/SteamTrace.h"
+
+#if STEAM_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(SteamChannel);
+#endif
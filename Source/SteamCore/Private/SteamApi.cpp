@@ -5,6 +5,7 @@
 
 #include "steam/steam_api.h"
 #include "Globals.h"
+#include "Profiling/SteamIPCStats.h"
 #include "Engine/EngineTypes.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
@@ -32,7 +33,7 @@ int USteamApi::GetAppID()
 {
 	if (SteamUtils())
 	{
-		return SteamUtils()->GetAppID();
+		return STEAM_IPC_CALL(Core, SteamUtils(), GetAppID);
 	}
 	
 	return 0;
@@ -3,64 +3,193 @@
 #include "SteamCore.h"
 
 #include "Globals.h"
+#include "Callbacks/SteamCallbackPump.h"
+#include "Logging/SteamLogQueue.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/SteamIPCStats.h"
+#include "Profiling/SteamTrace.h"
+#include "Settings/SteamCoreSettings.h"
 #include "steam/isteamutils.h"
 #include "steam/steam_api.h"
 
+#if WITH_EDITOR
+#include "ISettingsModule.h"
+#endif
+
 #define LOCTEXT_NAMESPACE "FSteamCoreModule"
 
 DEFINE_LOG_CATEGORY(SteamCoreLog);
 
 extern "C" void __cdecl SteamAPIDebugTextHook( int nSeverity, const char *pchDebugText )
 {
-	switch (nSeverity)
-	{
-	case 0:
-		UE_LOG(SteamCoreLog, Log, TEXT("%hs"), pchDebugText);
-		break;
-	case 1:
-		UE_LOG(SteamCoreLog, Warning, TEXT("%hs"), pchDebugText);
-		break;
-	default:
-		UE_LOG(SteamCoreLog, Error, TEXT("%hs"), pchDebugText);
-		break;
-	}
+	//called on whatever thread the Steam client reports from, only copy the message here and log it when the queue is drained
+	FSteamLogQueue::Get().Push(nSeverity, pchDebugText);
 }
 
+FSteamCoreModule::~FSteamCoreModule() = default;
+
 void FSteamCoreModule::StartupModule()
 {
+#if WITH_EDITOR
+	ISettingsModule& SettingsModule = FModuleManager::LoadModuleChecked<ISettingsModule>("Settings");
+	SettingsModule.RegisterSettings("Project", "Plugins", "SteamCore", LOCTEXT("SteamCoreName", "Steam Core Settings"), LOCTEXT("SteamCoreDescription", "Steam Core Settings"), GetMutableDefault<USteamCoreSettings>());
+#endif
+
+	CallbackStatsCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Steam.CallbackStats"),
+		TEXT("Logs how often every routed Steam callback was dispatched and how long its handlers took."),
+		FConsoleCommandDelegate::CreateRaw(this, &FSteamCoreModule::DumpCallbackStats)
+		);
+
+	IPCStatsCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Steam.IPCStats"),
+		TEXT("Logs how often every Steam method was called by the plugin and how long the calls took."),
+		FConsoleCommandDelegate::CreateLambda([]() {FSteamIPCStats::Get().DumpTotals();})
+		);
+
 	ClientHandle = FSteamSharedModule::Get().ObtainSteamClientInstanceHandle();
 
 	if (!ClientHandle)
 		return;
 	
 	SteamUtils()->SetWarningMessageHook(&SteamAPIDebugTextHook);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddLambda([]()
+	{
+		FSteamLogQueue::Get().Drain();
+		FSteamIPCStats::Get().EndFrame();
+	});
 	UE_LOG(SteamCoreLog, Log, TEXT("Steam Warnings hooked"));
 
+	const USteamCoreSettings* Settings = GetDefault<USteamCoreSettings>();
+	if (Settings->DispatchMode == ESteamCallbackDispatchMode::Manual)
+	{
+		SteamAPI_ManualDispatch_Init();
+		CallbackRouter.SetManualDispatch(true);
+		UE_LOG(SteamCoreLog, Log, TEXT("Steam callbacks are dispatched manually"));
+	}
+
+	CallResults.Initialize(CallbackRouter);
+
 	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
 		FTickerDelegate::CreateRaw(this, &FSteamCoreModule::Tick)
 		);
 	
 	Initialized = true;
+
+	//automatic dispatch runs every CCallback in the process from SteamAPI_RunCallbacks, those have to stay on the game thread
+	if (Settings->bPumpCallbacksOnWorkerThread && !CallbackRouter.IsManualDispatch())
+	{
+		UE_LOG(SteamCoreLog, Warning, TEXT("bPumpCallbacksOnWorkerThread requires the Manual dispatch mode, callbacks are pumped on the game thread"));
+	}
+	else if (Settings->bPumpCallbacksOnWorkerThread)
+	{
+		CallbackPump = MakeUnique<FSteamCallbackPump>(Settings->CallbackPumpRate, [this]() {PumpCallbacks();});
+	}
 }
 
 void FSteamCoreModule::ShutdownModule()
 {
+	if (CallbackStatsCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(CallbackStatsCommand);
+		CallbackStatsCommand = nullptr;
+	}
+
+	if (IPCStatsCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(IPCStatsCommand);
+		IPCStatsCommand = nullptr;
+	}
+
+#if WITH_EDITOR
+	if (FModuleManager::Get().IsModuleLoaded("Settings"))
+	{
+		ISettingsModule& SettingsModule = FModuleManager::GetModuleChecked<ISettingsModule>("Settings");
+		SettingsModule.UnregisterSettings("Project", "Plugins", "SteamCore");
+	}
+#endif
+
+	Initialized = false;
+	CallbackPump.Reset();
 	ClientHandle.Reset();
 
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+	FSteamLogQueue::Get().Drain();
+
 	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
 	TickHandle.Reset();
 }
 
 bool FSteamCoreModule::Tick(float DeltaTime)
 {
+	STEAM_TRACE_SCOPE(SteamCore_Tick);
+
 	if (Initialized)
 	{
-		SteamAPI_RunCallbacks();
+		if (!CallbackPump.IsValid())
+		{
+			PumpCallbacks();
+		}
+
+		CallbackRouter.FlushGameThreadCallbacks();
 	}
 
 	return true;
 }
 
+void FSteamCoreModule::PumpCallbacks()
+{
+	STEAM_TRACE_SCOPE(SteamCore_RunCallbacks);
+
+	if (CallbackRouter.IsManualDispatch())
+	{
+		RunManualDispatch();
+	}
+	else
+	{
+		//call results complete through their own registrations from within RunCallbacks
+		FScopeLock RunFrameScope(&RunFrameLock);
+		SteamAPI_RunCallbacks();
+	}
+}
+
+void FSteamCoreModule::RunManualDispatch()
+{
+	const HSteamPipe SteamPipe = SteamAPI_GetHSteamPipe();
+	if (!SteamPipe)
+	{
+		return;
+	}
+
+	{
+		FScopeLock RunFrameScope(&RunFrameLock);
+		SteamAPI_ManualDispatch_RunFrame(SteamPipe);
+	}
+
+	CallbackMsg_t Callback;
+	while (SteamAPI_ManualDispatch_GetNextCallback(SteamPipe, &Callback))
+	{
+		CallbackRouter.Dispatch(Callback.m_iCallback, Callback.m_pubParam, Callback.m_cubParam);
+		SteamAPI_ManualDispatch_FreeLastCallback(SteamPipe);
+	}
+}
+
+void FSteamCoreModule::DumpCallbackStats() const
+{
+	TArray<FSteamCallbackStats> Stats;
+	CallbackRouter.GetStats(Stats);
+	Stats.Sort([](const FSteamCallbackStats& A, const FSteamCallbackStats& B) {return A.TotalSeconds > B.TotalSeconds;});
+
+	UE_LOG(SteamCoreLog, Log, TEXT("Steam callback stats (%s dispatch, %llu unhandled):"), CallbackRouter.IsManualDispatch() ? TEXT("manual") : TEXT("automatic"), CallbackRouter.GetUnhandledCount());
+	for (const FSteamCallbackStats& Stat : Stats)
+	{
+		UE_LOG(SteamCoreLog, Log, TEXT("  Callback %5d: %8llu dispatches, %.3f ms total, %.3f ms max"), Stat.CallbackId, Stat.Count, Stat.TotalSeconds * 1000.0, Stat.MaxSeconds * 1000.0);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
     
 IMPLEMENT_MODULE(FSteamCoreModule, SteamCore)
\ No newline at end of file
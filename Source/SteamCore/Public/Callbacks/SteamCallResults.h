@@ -0,0 +1,158 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Templates/UniquePtr.h"
+
+class FSteamCallbackRouter;
+class FSteamCallResultBridge;
+struct SteamAPICallCompleted_t;
+
+/** Outcome of a Steam call result */
+template<typename ResultType>
+struct TSteamCallResult
+{
+	/** The result struct, zeroed when the call failed */
+	ResultType Result{};
+	/** True if the call failed, was cancelled or Steam shut down before it completed */
+	bool bIOFailure = true;
+
+	bool IsSuccess() const {return !bIOFailure;}
+};
+
+/**
+ * Turns SteamAPICall_t handles into futures, completed from the SteamCore callback pump.
+ * Pending calls live in a pooled table that stores their promises in place, so the future state is the only allocation per call.
+ * With manual dispatch they complete from the SteamAPICallCompleted_t callback, otherwise every slot owns a call result registration
+ * that SteamAPI_RunCallbacks completes, so no pending call is ever polled.
+ * Futures complete on the thread that pumps callbacks, continuations that need the game thread have to marshal themselves.
+ */
+class STEAMCORE_API FSteamCallResults
+{
+public:
+	FSteamCallResults();
+	~FSteamCallResults();
+
+	/// Await the result of an asynchronous Steam call
+	/// @tparam ResultType Call result struct of the call, for example LobbyCreated_t
+	/// @param Call Handle returned by the Steam API, k_uAPICallInvalid completes immediately with a failure
+	/// @return Future receiving the result
+	template<typename ResultType>
+	TFuture<TSteamCallResult<ResultType>> Await(const uint64 Call)
+	{
+		using FPromise = TPromise<TSteamCallResult<ResultType>>;
+		static_assert(sizeof(FPromise) <= sizeof(FPromiseStorage) && alignof(FPromise) <= alignof(FPromiseStorage), "TPromise no longer fits the pending call storage");
+
+		FPendingCall PendingCall;
+		PendingCall.Call = Call;
+		PendingCall.CallbackId = ResultType::k_iCallback;
+		PendingCall.ResultSize = sizeof(ResultType);
+		FPromise* Promise = new (&PendingCall.PromiseStorage) FPromise();
+		PendingCall.Completion = &CompletePromise<ResultType>;
+		TFuture<TSteamCallResult<ResultType>> Future = Promise->GetFuture();
+
+		AddPendingCall(MoveTemp(PendingCall));
+		return Future;
+	}
+
+	/// Complete a pending call with a failure
+	void Cancel(uint64 Call);
+	/// Amount of calls that have not completed yet
+	int32 GetNumPending() const;
+
+	/// Start receiving completions, with manual dispatch they arrive as callbacks through the router
+	void Initialize(FSteamCallbackRouter& Router);
+
+private:
+	friend class FSteamCallResultBridge;
+
+	/** Every TPromise is a single pointer to its shared state whatever the result type, so one storage fits all of them */
+	using FPromiseStorage = TTypeCompatibleBytes<TPromise<TSteamCallResult<uint8>>>;
+
+	/// Set the value of the TPromise in Storage and destroy it
+	/// @param Data Result struct, null when the call failed
+	template<typename ResultType>
+	static void CompletePromise(void* Storage, const void* Data, const bool bIOFailure)
+	{
+		using FPromise = TPromise<TSteamCallResult<ResultType>>;
+		FPromise& Promise = *static_cast<FPromise*>(Storage);
+
+		TSteamCallResult<ResultType> Result;
+		if (Data)
+		{
+			FMemory::Memcpy(&Result.Result, Data, sizeof(ResultType));
+		}
+		Result.bIOFailure = bIOFailure || !Data;
+
+		Promise.SetValue(MoveTemp(Result));
+		Promise.~FPromise();
+	}
+
+	struct FPendingCall
+	{
+		uint64 Call = 0;
+		int32 CallbackId = 0;
+		int32 ResultSize = 0;
+		/** CompletePromise for the result type of the call, null once the promise was completed or moved away */
+		void (*Completion)(void* Storage, const void* Data, bool bIOFailure) = nullptr;
+		/** Call result registration of the slot, null with manual dispatch */
+		FSteamCallResultBridge* Bridge = nullptr;
+		FPromiseStorage PromiseStorage;
+
+		FPendingCall() = default;
+		FPendingCall(FPendingCall&& Other) {*this = MoveTemp(Other);}
+		~FPendingCall() {Complete(nullptr, true);}
+
+		FPendingCall& operator=(FPendingCall&& Other)
+		{
+			if (this != &Other)
+			{
+				Complete(nullptr, true);
+
+				Call = Other.Call;
+				CallbackId = Other.CallbackId;
+				ResultSize = Other.ResultSize;
+				Bridge = Other.Bridge;
+
+				//promises move bitwise, the same way TArray relocates its elements
+				Completion = Other.Completion;
+				FMemory::Memcpy(&PromiseStorage, &Other.PromiseStorage, sizeof(FPromiseStorage));
+				Other.Completion = nullptr;
+			}
+			return *this;
+		}
+
+		/// Complete the promise if the call still holds one, a promise dropped without a value would leave its future waiting forever
+		void Complete(const void* Data, const bool bIOFailure)
+		{
+			if (void (*Fn)(void*, const void*, bool) = Completion)
+			{
+				Completion = nullptr;
+				Fn(&PromiseStorage, Data, bIOFailure);
+			}
+		}
+	};
+
+	void AddPendingCall(FPendingCall&& PendingCall);
+	bool TakePendingCall(int32 SlotIndex, FPendingCall& OutPendingCall);
+	void OnCallCompleted(const SteamAPICallCompleted_t& Completed);
+	/// Complete a call through the call result registration of its slot, automatic dispatch only
+	void OnCallResult(uint64 Call, const void* Data, bool bIOFailure);
+	/// Drop the registration of a call taken from its slot and complete its promise, called without the lock held
+	void FinishPendingCall(FPendingCall& PendingCall, const void* Data, bool bIOFailure);
+
+	/** Pooled pending calls, slots with a Call of 0 are free */
+	TArray<FPendingCall> Slots;
+	/** Per slot, the call result registration used with automatic dispatch. Heap allocated as Steam keeps pointers to them */
+	TArray<TUniquePtr<FSteamCallResultBridge>> Bridges;
+	TArray<int32> FreeSlots;
+	TMap<uint64, int32> SlotByCall;
+	mutable FCriticalSection Mutex;
+	bool bManualDispatch = false;
+
+	/** Scratch buffer results get copied into, only touched by the pump thread */
+	TArray<uint8, TAlignedHeapAllocator<16>> ResultBuffer;
+};
@@ -0,0 +1,147 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSteamCallbackBridge;
+
+/** Thread a callback handler has to be invoked on */
+enum class ESteamCallbackThread : uint8
+{
+	/** Invoked on the game thread, queued there when callbacks are pumped on the SteamCore worker thread */
+	GameThread,
+	/** Invoked directly on whichever thread pumps the callbacks */
+	AnyThread
+};
+
+/** Identifies a handler registered with FSteamCallbackRouter */
+struct FSteamCallbackHandle
+{
+	int32 CallbackId = INDEX_NONE;
+	uint32 HandlerId = 0;
+
+	bool IsValid() const {return HandlerId != 0;}
+};
+
+/** Dispatch statistics for a single callback id */
+struct FSteamCallbackStats
+{
+	int32 CallbackId = INDEX_NONE;
+	/** Amount of times the callback was dispatched */
+	uint64 Count = 0;
+	/** Time spent in the handlers of this callback, in seconds */
+	double TotalSeconds = 0.0;
+	double MaxSeconds = 0.0;
+};
+
+/**
+ * Routes Steam callbacks to C++ handlers through a flat table keyed by callback id.
+ * With manual dispatch the router is fed directly by FSteamCoreModule, otherwise a single CCallbackBase per callback id bridges the
+ * SDK registry into the router. Handlers are invoked in registration order, AnyThread handlers on the thread that pumps the callbacks
+ * and GameThread handlers on the game thread, queued with a copy of the callback data when the pump runs elsewhere.
+ * Handlers run without any lock held, so they are free to register and unregister, and a slow handler on one thread never stalls
+ * the other. A handler unregistered while another thread is dispatching to it may still finish that one invocation.
+ */
+class STEAMCORE_API FSteamCallbackRouter
+{
+public:
+	FSteamCallbackRouter();
+	~FSteamCallbackRouter();
+
+	/// Register a handler for a Steam callback struct
+	/// @tparam CallbackType Steam callback struct, for example SteamInputConfigurationLoaded_t
+	/// @param Handler Function to call with the callback data
+	/// @param Thread Thread the handler needs to run on
+	/// @return Handle to unregister the handler with
+	template<typename CallbackType>
+	FSteamCallbackHandle Register(TFunction<void(const CallbackType&)> Handler, const ESteamCallbackThread Thread = ESteamCallbackThread::GameThread)
+	{
+		return RegisterRaw(CallbackType::k_iCallback, sizeof(CallbackType), [Handler = MoveTemp(Handler)](const void* Data)
+		{
+			Handler(*static_cast<const CallbackType*>(Data));
+		}, Thread);
+	}
+
+	/// Register a handler for a callback id, the handler receives the raw callback data
+	/// @param CallbackId k_iCallback of the callback struct
+	/// @param CallbackSize sizeof the callback struct
+	/// @param Handler Function to call with the callback data
+	/// @param Thread Thread the handler needs to run on
+	/// @return Handle to unregister the handler with
+	FSteamCallbackHandle RegisterRaw(int32 CallbackId, int32 CallbackSize, TFunction<void(const void*)> Handler, ESteamCallbackThread Thread = ESteamCallbackThread::GameThread);
+
+	/// Remove a handler, safe to call from within a handler. An invocation already running on another thread is not waited for
+	void Unregister(FSteamCallbackHandle& Handle);
+
+	/// Invoke every handler registered for the callback id, GameThread handlers get queued when called from another thread
+	/// @return false if no handler is registered for the callback
+	bool Dispatch(int32 CallbackId, const void* Data, int32 DataSize);
+	/// Invoke the GameThread handlers of every callback queued by the pump thread, called from the game thread
+	void FlushGameThreadCallbacks();
+
+	/// Switch between feeding the router manually and bridging the SDK callback registry, only valid before any handler is registered
+	void SetManualDispatch(bool bInManualDispatch);
+	bool IsManualDispatch() const {return bManualDispatch;}
+
+	/// Collect dispatch statistics for every registered callback id
+	void GetStats(TArray<FSteamCallbackStats>& OutStats) const;
+	/// Amount of callbacks dispatched without any handler registered, only counted with manual dispatch
+	uint64 GetUnhandledCount() const {return UnhandledCount;}
+	void ResetStats();
+
+private:
+	using FHandlerFunction = TSharedRef<const TFunction<void(const void*)>, ESPMode::ThreadSafe>;
+	/** Handlers copied out of a slot to be invoked once the lock is released */
+	using FHandlerList = TArray<TSharedPtr<const TFunction<void(const void*)>, ESPMode::ThreadSafe>, TInlineAllocator<4>>;
+
+	struct FHandler
+	{
+		uint32 HandlerId = 0;
+		ESteamCallbackThread Thread = ESteamCallbackThread::GameThread;
+		/** Shared so a dispatch can keep invoking it after the handler was unregistered */
+		FHandlerFunction Function;
+	};
+
+	struct FSlot
+	{
+		int32 CallbackId = INDEX_NONE;
+		int32 CallbackSize = 0;
+		TArray<FHandler, TInlineAllocator<2>> Handlers;
+		int32 NumGameThreadHandlers = 0;
+		TUniquePtr<FSteamCallbackBridge> Bridge;
+		FSteamCallbackStats Stats;
+	};
+
+	/** Index into Slots for every callback id, INDEX_NONE when nothing is registered */
+	TArray<int32> SlotIndexById;
+	TArray<FSlot> Slots;
+
+	struct FQueuedCallback
+	{
+		int32 CallbackId = INDEX_NONE;
+		int32 Offset = 0;
+		int32 Size = 0;
+	};
+
+	/** Callbacks waiting for their GameThread handlers, the data of all of them packed into a single buffer */
+	TArray<FQueuedCallback> QueuedCallbacks;
+	TArray<uint8, TAlignedHeapAllocator<16>> QueuedData;
+	/** Swapped with the queue while flushing, so steady state queuing doesn't allocate */
+	TArray<FQueuedCallback> FlushingCallbacks;
+	TArray<uint8, TAlignedHeapAllocator<16>> FlushingData;
+	FCriticalSection QueueMutex;
+
+	/** Guards the slots and the statistics, never held while a handler runs */
+	mutable FCriticalSection Mutex;
+	uint32 NextHandlerId = 1;
+	bool bManualDispatch = false;
+	uint64 UnhandledCount = 0;
+
+	void AddHandler(int32 CallbackId, int32 CallbackSize, FHandler&& NewHandler);
+	/// Copy the handlers of a slot that run on the requested threads, called with Mutex held
+	void CollectHandlers(int32 SlotIndex, bool bGameThreadHandlers, bool bAnyThreadHandlers, FHandlerList& OutHandlers) const;
+	/// Invoke collected handlers without holding Mutex and add the time spent to the statistics of the callback
+	void InvokeHandlers(int32 CallbackId, const FHandlerList& Handlers, const void* Data, bool bCount);
+	void QueueForGameThread(int32 CallbackId, const void* Data, int32 DataSize);
+};
@@ -0,0 +1,113 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Profiling/SteamTrace.h"
+
+#include <atomic>
+
+#ifndef STEAM_IPC_STATS
+#define STEAM_IPC_STATS !UE_BUILD_SHIPPING
+#endif
+
+DECLARE_STATS_GROUP(TEXT("Steam IPC"), STATGROUP_SteamIPC, STATCAT_Advanced);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(STEAMCORE_API, SteamIPC);
+
+/** Part of the plugin a Steam call is made from */
+enum class ESteamIPCSubsystem : uint8
+{
+	Core,
+	Input,
+	Glyphs,
+	Haptics,
+	Debug,
+	Num
+};
+
+/**
+ * Counts calls into the Steam client and the time they take, per method and per calling subsystem.
+ * Calls are recorded through STEAM_IPC_CALL, the counters are published once per frame to STATGROUP_SteamIPC and the SteamIPC CSV category
+ * together with ISteamUtils::GetIPCCallCount.
+ */
+class STEAMCORE_API FSteamIPCStats
+{
+public:
+	static FSteamIPCStats& Get();
+
+	/// Register a call site, call sites of the same method and subsystem share their counters
+	/// @return Id to record the calls with, INDEX_NONE once the table is full
+	int32 RegisterCallSite(const TCHAR* MethodName, ESteamIPCSubsystem Subsystem);
+
+	/// Record a single call, safe to call from any thread
+	void Record(const int32 CallSiteId, const uint64 Cycles)
+	{
+		if (CallSiteId != INDEX_NONE)
+		{
+			Entries[CallSiteId].FrameCalls.fetch_add(1, std::memory_order_relaxed);
+			Entries[CallSiteId].FrameCycles.fetch_add(Cycles, std::memory_order_relaxed);
+		}
+	}
+
+	/// Publish and reset the counters of the current frame, called by SteamCore at the end of every frame
+	void EndFrame();
+
+	/// Log the totals of every method
+	void DumpTotals() const;
+
+	static const TCHAR* GetSubsystemName(ESteamIPCSubsystem Subsystem);
+
+private:
+	struct FEntry
+	{
+		const TCHAR* MethodName = nullptr;
+		ESteamIPCSubsystem Subsystem = ESteamIPCSubsystem::Core;
+		FName CsvStatName;
+
+		std::atomic<uint32> FrameCalls{0};
+		std::atomic<uint64> FrameCycles{0};
+
+		/** Only touched by EndFrame */
+		uint64 TotalCalls = 0;
+		uint64 TotalCycles = 0;
+	};
+
+	static constexpr int32 MaxEntries = 256;
+
+	FEntry Entries[MaxEntries];
+	std::atomic<int32> NumEntries{0};
+	FCriticalSection RegisterMutex;
+};
+
+/** Times a single Steam call for FSteamIPCStats */
+struct FSteamIPCScope
+{
+	explicit FSteamIPCScope(const int32 InCallSiteId) : CallSiteId(InCallSiteId), StartCycles(FPlatformTime::Cycles64()) {}
+	~FSteamIPCScope()
+	{
+		FSteamIPCStats::Get().Record(CallSiteId, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	int32 CallSiteId;
+	uint64 StartCycles;
+};
+
+/**
+ * Call a method of a Steam interface, account it to a subsystem and trace it on SteamChannel, for example
+ * STEAM_IPC_CALL(Input, SteamInput(), GetDigitalActionData, Controller, Handle)
+ */
+#if STEAM_IPC_STATS
+#define STEAM_IPC_CALL(Subsystem, Interface, Method, ...) \
+	([&]() -> decltype(auto) \
+	{ \
+		static const int32 SteamIPCCallSite = FSteamIPCStats::Get().RegisterCallSite(TEXT(#Method), ESteamIPCSubsystem::Subsystem); \
+		const FSteamIPCScope SteamIPCScope(SteamIPCCallSite); \
+		STEAM_TRACE_SCOPE_STR("Steam::" #Method); \
+		return (Interface)->Method(__VA_ARGS__); \
+	}())
+#else
+#define STEAM_IPC_CALL(Subsystem, Interface, Method, ...) ((Interface)->Method(__VA_ARGS__))
+#endif
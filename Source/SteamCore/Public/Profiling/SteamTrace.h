@@ -0,0 +1,28 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#ifndef STEAM_TRACE_ENABLED
+#define STEAM_TRACE_ENABLED (UE_TRACE_ENABLED && CPUPROFILERTRACE_ENABLED)
+#endif
+
+/**
+ * Unreal Insights channel of the Steam plugins, enable it with -trace=cpu,SteamChannel or Trace.Enable SteamChannel.
+ * Carries the CPU scopes of callback pumping, input dispatch, glyph loads and every Steam call made through STEAM_IPC_CALL,
+ * plus the input events emitted by SteamInput, so input, Steam stalls and frame hitches line up on one timeline.
+ */
+#if STEAM_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(SteamChannel, STEAMCORE_API);
+
+/** Scoped CPU event on SteamChannel, Name is an identifier like SteamCore_Tick */
+#define STEAM_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, SteamChannel)
+/** Scoped CPU event on SteamChannel named by a string literal */
+#define STEAM_TRACE_SCOPE_STR(NameStr) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(NameStr, SteamChannel)
+#else
+#define STEAM_TRACE_SCOPE(Name)
+#define STEAM_TRACE_SCOPE_STR(NameStr)
+#endif
@@ -6,11 +6,35 @@
 #include "UObject/Object.h"
 #include "SteamCoreSettings.generated.h"
 
+UENUM()
+enum class ESteamCallbackDispatchMode : uint8
+{
+	/** Callbacks are dispatched by SteamAPI_RunCallbacks through the SDK callback registry */
+	Automatic,
+	/** Callbacks are pulled with SteamAPI_ManualDispatch and routed straight to the handlers registered with the SteamCore callback router */
+	Manual
+};
+
 /**
  * 
  */
-UCLASS(Config = Core)
+UCLASS(Config = Core, DefaultConfig)
 class STEAMCORE_API USteamCoreSettings : public UObject
 {
 	GENERATED_BODY()
+public:
+	// How Steam callbacks are dispatched, requires a restart. With Manual dispatch CCallback objects outside of the SteamCore router
+	// (for example the ones of OnlineSubsystemSteam) no longer receive callbacks
+	UPROPERTY(Config, EditAnywhere, Category = "Callbacks", meta = (ConfigRestartRequired = true))
+	ESteamCallbackDispatchMode DispatchMode = ESteamCallbackDispatchMode::Automatic;
+
+	// Pump Steam callbacks on a SteamCore worker thread instead of the game thread, handlers that need the game thread get queued to it.
+	// Only with Manual dispatch, SteamAPI_RunCallbacks would run every CCallback of the process on the worker, OnlineSubsystemSteam included.
+	// Steam Input frames then run on the worker as well, SteamInput runs its own frame on the game thread before polling in every sampling mode
+	UPROPERTY(Config, EditAnywhere, Category = "Callbacks", meta = (EditCondition = "DispatchMode == ESteamCallbackDispatchMode::Manual", ConfigRestartRequired = true))
+	bool bPumpCallbacksOnWorkerThread = false;
+
+	// Rate at which the worker thread pumps callbacks
+	UPROPERTY(Config, EditAnywhere, Category = "Callbacks", meta = (EditCondition = "DispatchMode == ESteamCallbackDispatchMode::Manual && bPumpCallbacksOnWorkerThread", ClampMin = "10", ClampMax = "1000", Units = "Hz", ConfigRestartRequired = true))
+	float CallbackPumpRate = 120.0f;
 };
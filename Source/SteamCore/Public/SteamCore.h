@@ -6,10 +6,16 @@
 #include "SteamSharedModule.h"
 #include "Modules/ModuleManager.h"
 #include "Containers/Ticker.h"
+#include "Callbacks/SteamCallbackRouter.h"
+#include "Callbacks/SteamCallResults.h"
 
-class FSteamCoreModule : public IModuleInterface
+struct IConsoleCommand;
+class FSteamCallbackPump;
+
+class STEAMCORE_API FSteamCoreModule : public IModuleInterface
 {
 public:
+    virtual ~FSteamCoreModule() override;
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
     virtual bool SupportsDynamicReloading() override {return false;}
@@ -20,13 +26,35 @@ public:
     };
 
     bool IsInitialized() const {return Initialized;}
+
+    /** Router every Steam callback of the plugin is registered through */
+    FSteamCallbackRouter& GetCallbackRouter() {return CallbackRouter;}
+    /** Awaitable results of asynchronous Steam calls, completed from the callback pump */
+    FSteamCallResults& GetCallResults() {return CallResults;}
+    /** Held while the callback pump runs a Steam frame, anything else running ISteamInput::RunFrame takes it so frames never run on two threads at once */
+    FCriticalSection& GetRunFrameLock() {return RunFrameLock;}
+    /** Whether Steam frames run on the worker thread of bPumpCallbacksOnWorkerThread, game thread code that wants a fresh frame runs its own then */
+    bool IsPumpingOnWorkerThread() const {return CallbackPump.IsValid();}
     
 private:
     TSharedPtr<class FSteamClientInstanceHandler> ClientHandle;
     bool Initialized = false;
 
+    FSteamCallbackRouter CallbackRouter;
+    FSteamCallResults CallResults;
+    /** Only valid when callbacks are pumped on the worker thread */
+    TUniquePtr<FSteamCallbackPump> CallbackPump;
+    FCriticalSection RunFrameLock;
+    IConsoleCommand* CallbackStatsCommand = nullptr;
+    IConsoleCommand* IPCStatsCommand = nullptr;
+
     virtual bool Tick( float DeltaTime );
+    void PumpCallbacks();
+    void RunManualDispatch();
+    void DumpCallbackStats() const;
     
     //Steam needs to have regular tick updates
     FTSTicker::FDelegateHandle TickHandle;
+    //queued Steam warnings get logged at the end of every frame
+    FDelegateHandle EndFrameHandle;
 };
@@ -3,6 +3,7 @@
 #include "Windows/SInputMonitor.h"
 
 #include "Helper/SteamInputFunctionLibrary.h"
+#include "Profiling/SteamIPCStats.h"
 #include "Settings/SteamInputSettings.h"
 #include "steam/isteamcontroller.h"
 #include "Subsystems/USteamDebugSubsystem.h"
@@ -316,7 +317,7 @@ bool SInputMonitor::IsActionActive(const FSteamInputAction& Action) const
 	// Get the controller handle
 	InputHandle_t Controllers[STEAM_INPUT_MAX_COUNT];
 	
-	if (SteamInput()->GetConnectedControllers(Controllers) < SelectedControllerIndex)
+	if (STEAM_IPC_CALL(Debug, SteamInput(), GetConnectedControllers, Controllers) < SelectedControllerIndex)
 	{
 		return false;
 	}
@@ -326,7 +327,7 @@ bool SInputMonitor::IsActionActive(const FSteamInputAction& Action) const
 	{
 	case EKeyType::Button:
 		{
-			InputDigitalActionData_t Data = SteamInput()->GetDigitalActionData(
+			InputDigitalActionData_t Data = STEAM_IPC_CALL(Debug, SteamInput(), GetDigitalActionData,
 				Controllers[SelectedControllerIndex], 
 				Action.CachedHandle
 			);
@@ -337,7 +338,7 @@ bool SInputMonitor::IsActionActive(const FSteamInputAction& Action) const
 	case EKeyType::Joystick:
 	case EKeyType::MouseInput:
 		{
-			InputAnalogActionData_t Data = SteamInput()->GetAnalogActionData(
+			InputAnalogActionData_t Data = STEAM_IPC_CALL(Debug, SteamInput(), GetAnalogActionData,
 				Controllers[SelectedControllerIndex],
 				Action.CachedHandle
 			);
@@ -358,7 +359,7 @@ bool SInputMonitor::IsControllerConnected(int32 Index) const
 	if (SteamInput())
 	{
 		InputHandle_t Controllers[STEAM_INPUT_MAX_COUNT];
-		SteamInput()->GetConnectedControllers(Controllers);
+		STEAM_IPC_CALL(Debug, SteamInput(), GetConnectedControllers, Controllers);
 		return (Controllers[Index] != 0);
 	}
 	
@@ -396,7 +397,7 @@ FInputDeviceId SInputMonitor::GetIdFromIndex(const int32 ControllerIndex) const
 		return INPUTDEVICEID_NONE;
 	
 	InputHandle_t Controllers[STEAM_INPUT_MAX_COUNT];
-	if (SteamInput()->GetConnectedControllers(Controllers) < ControllerIndex)
+	if (STEAM_IPC_CALL(Debug, SteamInput(), GetConnectedControllers, Controllers) < ControllerIndex)
 		return INPUTDEVICEID_NONE;
 		
 	return USteamInputFunctionLibrary::GetDeviceIDFromSteamID(Controllers[ControllerIndex]);
@@ -26,7 +26,8 @@ public class SteamDebug : ModuleRules
                 "Slate",
                 "SlateCore",
                 "ToolMenus",
-                "InputCore"
+                "InputCore",
+                "SteamCore"
             }
         );
         
@@ -3,19 +3,83 @@
 #include "Controller/FSteamInputController.h"
 
 #include "Globals.h"
+#include "SteamCore.h"
+#include "Controller/FSteamInputMotionSampler.h"
+#include "Controller/FSteamInputSampler.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Controller/SteamInputLatency.h"
+#include "Controller/SteamInputLateLatch.h"
+#include "Controller/SteamInputSource.h"
 #include "Helper/SteamInputFunctionLibrary.h"
+#include "Helper/SteamInputQueryCache.h"
+#include "Profiling/SteamInputStats.h"
+#include "Profiling/SteamIPCStats.h"
+#include "Profiling/SteamTrace.h"
 #include "Settings/SteamInputSettings.h"
 #include "CoreGlobals.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
 
-FSteamInputController::FSteamInputController(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler) : MessageHandler(InMessageHandler)
+#if STEAM_TRACE_ENABLED
+UE_TRACE_EVENT_BEGIN(SteamInput, ControllerEvent)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(double, SampleTime)
+	UE_TRACE_EVENT_FIELD(int32, UserId)
+	UE_TRACE_EVENT_FIELD(int32, DeviceId)
+	UE_TRACE_EVENT_FIELD(uint8, Type)
+	UE_TRACE_EVENT_FIELD(float, Value)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Key)
+UE_TRACE_EVENT_END()
+#endif
+
+namespace
+{
+	enum class ESteamInputTraceEvent : uint8
+	{
+		Pressed,
+		Repeated,
+		Released,
+		Axis
+	};
+
+	/** Log an event handed to the message handler on SteamChannel, SampleTime is when the underlying sample was polled */
+	void TraceControllerEvent(const ESteamInputTraceEvent Type, const FName& Key, const FPlatformUserId UserID, const FInputDeviceId DeviceId,
+		const double SampleTime, const float Value = 0.0f)
+	{
+#if STEAM_TRACE_ENABLED
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(SteamChannel))
+		{
+			TCHAR KeyName[NAME_SIZE];
+			const uint32 KeyLength = Key.ToString(KeyName);
+
+			UE_TRACE_LOG(SteamInput, ControllerEvent, SteamChannel)
+				<< ControllerEvent.Cycle(FPlatformTime::Cycles64())
+				<< ControllerEvent.SampleTime(SampleTime)
+				<< ControllerEvent.UserId(UserID.GetInternalId())
+				<< ControllerEvent.DeviceId(DeviceId.GetId())
+				<< ControllerEvent.Type(static_cast<uint8>(Type))
+				<< ControllerEvent.Value(Value)
+				<< ControllerEvent.Key(KeyName, KeyLength);
+		}
+#endif
+	}
+}
+
+FSteamInputController::FSteamInputController(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler)
+	: MessageHandler(InMessageHandler)
+	, InputSource(FSteamInputLiveSource::Get())
 {
 	GConfig->GetDouble(TEXT("/Script/Engine.InputSettings"), TEXT("InitialButtonRepeatDelay"), InitialButtonRepeatDelay, GInputIni);
 	GConfig->GetDouble(TEXT("/Script/Engine.InputSettings"), TEXT("ButtonRepeatDelay"), ButtonRepeatDelay, GInputIni);
 
+	//force feedback is set by the player controllers during the frame, send it once they all had their say
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSteamInputController::FlushVibration);
+
 	if (SteamInput())
 	{
 		bControllerInitialized = true;
+		HapticPlayer = MakeUnique<FSteamInputHapticPlayer>(GetDefault<USteamInputSettings>()->HapticPlaybackRate);
 
 		UE_LOG(SteamInputLog, Log, TEXT("Steam Input Controller initialized successfully"));
 	}
@@ -27,56 +91,406 @@ FSteamInputController::FSteamInputController(const TSharedRef<FGenericApplicatio
 
 FSteamInputController::~FSteamInputController()
 {
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
 	bControllerInitialized = false;
+	HapticPlayer.Reset();
+	Recorder.Stop();
+	MotionSampler.Reset();
+	Sampler.Reset();
+	SetActionEventsEnabled(false);
+}
+
+void FSteamInputController::SetInputSource(const TSharedPtr<ISteamInputSource, ESPMode::ThreadSafe>& InSource)
+{
+	const TSharedRef<ISteamInputSource, ESPMode::ThreadSafe> NewSource = InSource.IsValid() ? InSource.ToSharedRef() : FSteamInputLiveSource::Get();
+	if (NewSource == InputSource)
+	{
+		return;
+	}
+
+	//the sampler and the event handler are bound to the old source, they get recreated on the next frame
+	SetActionEventsEnabled(false);
+	Sampler.Reset();
+	for (auto& ControllerState : ControllerStates)
+	{
+		InputSource->SetPollList(ControllerState.Value.Handle, nullptr);
+		ControllerState.Value.PollList.Reset();
+	}
+	InputSource = NewSource;
+}
+
+bool FSteamInputController::StartRecording(const FString& Filename)
+{
+	UpdateActionTable();
+
+	if (!Recorder.Start(Filename.IsEmpty() ? SteamInputRecording::MakeDefaultFilename() : Filename, *ActionTable))
+	{
+		return false;
+	}
+
+	for (const auto& ControllerState : ControllerStates)
+	{
+		Recorder.RecordConnection(ControllerState.Value.Handle, true);
+	}
+
+	return true;
+}
+
+void FSteamInputController::StopRecording()
+{
+	Recorder.Stop();
+}
+
+void FSteamInputController::UpdateActionTable()
+{
+	const USteamInputSettings* Settings = GetDefault<USteamInputSettings>();
+	if (ActionTable.IsValid() && ActionTable->Revision == Settings->GetHandleRevision())
+	{
+		return;
+	}
+
+	ActionTable = FSteamInputActionTable::Build(*Settings);
+	AnalogFilter.Init(*ActionTable, *Settings);
+	GestureDetector.Init(*ActionTable, *Settings);
+	PollLists.Reset();
+	Recorder.RecordLayout(*ActionTable);
+
+	for (auto& ControllerState : ControllerStates)
+	{
+		InputSource->SetPollList(ControllerState.Value.Handle, nullptr);
+		ResetControllerState(ControllerState.Value);
+	}
+
+	if (Sampler.IsValid())
+	{
+		Sampler->SetActionTable(ActionTable);
+	}
+
+	//event indices refer to the table, rebind with the new one
+	if (bActionEventsEnabled)
+	{
+		SetActionEventsEnabled(false);
+		SetActionEventsEnabled(true);
+	}
+}
+
+void FSteamInputController::UpdateSampler()
+{
+	const USteamInputSettings* Settings = GetDefault<USteamInputSettings>();
+	//sources handing out whole samples are dispatched as they are, whatever the sampling mode
+	const bool bProvidesSamples = InputSource->ProvidesSamples();
+	const bool bWantsSampler = Settings->SamplingMode == ESteamInputSamplingMode::FixedRate && !bProvidesSamples;
+	const bool bWantsActionEvents = Settings->SamplingMode == ESteamInputSamplingMode::ActionEvents && !bProvidesSamples;
+
+	if (bActionEventsEnabled != bWantsActionEvents)
+	{
+		SetActionEventsEnabled(!bActionEventsEnabled);
+	}
+
+	//restart the sampler when the mode or its configuration changed
+	if (Sampler.IsValid() && (!bWantsSampler || Sampler->GetRingCapacity() != Settings->SampleBufferSize || !FMath::IsNearlyEqual(Sampler->GetSampleRate(), static_cast<double>(Settings->SampleRate))))
+	{
+		Sampler.Reset();
+	}
+
+	if (bWantsSampler && !Sampler.IsValid())
+	{
+		Sampler = MakeUnique<FSteamInputSampler>(InputSource, Settings->SampleRate, Settings->SampleBufferSize);
+		Sampler->SetActionTable(ActionTable);
+
+		for (auto& ControllerState : ControllerStates)
+		{
+			ControllerState.Value.LastSampleIndex = 0;
+		}
+	}
+
+	//motion is read from the hardware only, sources handing out samples have none
+	const bool bWantsMotion = Settings->bEnableMotion && bControllerInitialized && !bProvidesSamples;
+	if (bWantsMotion != MotionSampler.IsValid())
+	{
+		MotionSampler = bWantsMotion ? MakeShared<FSteamInputMotionSampler, ESPMode::ThreadSafe>() : nullptr;
+	}
+
+	//the sampler runs Steam's frames while it is alive, the sensors are read after those
+	if (Sampler.IsValid())
+	{
+		Sampler->SetMotionSampler(MotionSampler);
+	}
+}
+
+void FSteamInputController::UpdateLateLatch()
+{
+	const USteamInputSettings* Settings = GetDefault<USteamInputSettings>();
+	//only the sampler thread reads input after the game thread dispatched the frame
+	const bool bWantsLateLatch = Settings->bLateLatchCamera && Sampler.IsValid();
+
+	if (!bWantsLateLatch)
+	{
+		if (LateLatch.IsValid())
+		{
+			LateLatch.Reset();
+			LateLatchExtension.Reset();
+		}
+	}
+	else if (!LateLatch.IsValid() || !LateLatch->Matches(*Settings))
+	{
+		LateLatch = MakeShared<FSteamInputLateLatch, ESPMode::ThreadSafe>(*Settings);
+		LateLatchExtension = FSceneViewExtensions::NewExtension<FSteamInputLateLatchExtension>(LateLatch.ToSharedRef());
+	}
+
+	//the samplers may have been recreated, hand them the latch every frame
+	if (Sampler.IsValid())
+	{
+		Sampler->SetLateLatch(LateLatch, LateLatch.IsValid() ? ActionTable->FindAnalogIndex(LateLatch->GetStickAction()) : INDEX_NONE);
+	}
+	if (MotionSampler.IsValid())
+	{
+		MotionSampler->SetLateLatch(LateLatch);
+	}
+
+	if (!LateLatch.IsValid())
+	{
+		return;
+	}
+
+	//keep the current target while it stays with the primary user, otherwise take the first controller that is
+	IPlatformInputDeviceMapper& DeviceMapper = IPlatformInputDeviceMapper::Get();
+	const FPlatformUserId PrimaryUser = DeviceMapper.GetPrimaryPlatformUser();
+	auto IsPrimaryController = [&](const InputHandle_t Handle)
+	{
+		const FInputDeviceId DeviceId = USteamInputFunctionLibrary::DeviceMappings.FindDeviceId(Handle);
+		return DeviceId != INPUTDEVICEID_NONE && ControllerStates.Contains(Handle) && DeviceMapper.GetUserForInputDevice(DeviceId) == PrimaryUser;
+	};
+
+	InputHandle_t Target = LateLatch->GetTarget();
+	if (Target == 0 || !IsPrimaryController(Target))
+	{
+		Target = 0;
+		for (const auto& ControllerState : ControllerStates)
+		{
+			if (IsPrimaryController(ControllerState.Value.Handle))
+			{
+				Target = ControllerState.Value.Handle;
+				break;
+			}
+		}
+		LateLatch->SetTarget(Target);
+	}
+}
+
+void FSteamInputController::SetActionEventsEnabled(const bool bEnabled)
+{
+	if (bEnabled && ActionTable.IsValid())
+	{
+		bActionEventsEnabled = InputSource->SetActionEventHandler(ActionTable, [this](const FSteamInputActionEvent& Event) {OnActionEvent(Event);});
+		if (!bActionEventsEnabled)
+		{
+			UE_LOG(SteamInputLog, Warning, TEXT("Input source does not support action events, falling back to polling every frame"));
+		}
+	}
+	else if (bActionEventsEnabled)
+	{
+		InputSource->SetActionEventHandler(nullptr, nullptr);
+		bActionEventsEnabled = false;
+	}
+
+	FScopeLock Lock(&EventLock);
+	EventTable = bActionEventsEnabled ? ActionTable : nullptr;
+	EventStates.Reset();
+}
+
+void FSteamInputController::OnActionEvent(const FSteamInputActionEvent& Event)
+{
+	FScopeLock Lock(&EventLock);
+
+	if (!EventTable.IsValid())
+	{
+		return;
+	}
+
+	FEventState& EventState = EventStates.FindOrAdd(Event.Controller);
+	if (EventState.Current.TableRevision != EventTable->Revision || EventState.Current.Digital.Num() != EventTable->DigitalActions.Num())
+	{
+		EventState.Current.Init(*EventTable);
+	}
+
+	if (Event.bAnalog)
+	{
+		if (EventState.Current.Analog.IsValidIndex(Event.ActionIndex))
+		{
+			EventState.Current.Analog[Event.ActionIndex] = Event.Value;
+		}
+	}
+	else if (Event.ActionIndex >= 0 && Event.ActionIndex < EventState.Current.Digital.Num())
+	{
+		EventState.Current.Digital.Set(Event.ActionIndex, Event.bState);
+	}
+
+	//every event becomes a sample of its own, so a press and release within one frame are both dispatched
+	EventState.Current.SampleIndex = ++NextEventSampleIndex;
+	EventState.Current.Timestamp = Event.Timestamp;
+	EventState.Pending.Add(EventState.Current);
+
+	//a mouse delta belongs to the one event that reported it, later samples must not carry it again
+	if (Event.bAnalog && EventState.Current.Analog.IsValidIndex(Event.ActionIndex) && EventTable->AnalogActions[Event.ActionIndex].KeyType == EKeyType::MouseInput)
+	{
+		EventState.Current.Analog[Event.ActionIndex] = FVector2f::ZeroVector;
+	}
+}
+
+void FSteamInputController::ResetControllerState(FControllerState& State) const
+{
+	State.LastSample.Init(*ActionTable);
+	State.Edges.Init(*ActionTable);
+	State.DigitalRepeatTimes.Reset();
+	State.DigitalRepeatTimes.SetNumZeroed(ActionTable->DigitalActions.Num());
+	State.LastSampleIndex = 0;
+	State.PollList.Reset();
+	State.History.Init(*ActionTable, GetDefault<USteamInputSettings>()->InputHistoryLength);
+	State.MouseDeltas.Reset();
+	State.MouseDeltas.SetNumZeroed(ActionTable->AnalogActions.Num());
+	State.DispatchedMouseDeltas.Reset();
+	State.DispatchedMouseDeltas.SetNumZeroed(ActionTable->AnalogActions.Num());
+	State.DispatchedAnalog.Reset();
+	State.DispatchedAnalog.SetNumZeroed(ActionTable->AnalogActions.Num());
+	AnalogFilter.InitState(State.FilterState);
+	GestureDetector.InitState(State.GestureState);
+}
+
+void FSteamInputController::UpdatePollList(const InputActionSetHandle_t ActionSet, const TConstArrayView<InputActionSetHandle_t> Layers,
+	FControllerState& State)
+{
+	FPollListKey Key;
+	Key.ActionSet = ActionSet;
+	Key.Layers.Append(Layers.GetData(), Layers.Num());
+
+	TSharedPtr<const FSteamInputPollList, ESPMode::ThreadSafe>& PollList = PollLists.FindOrAdd(MoveTemp(Key));
+	if (!PollList.IsValid())
+	{
+		const TSharedRef<FSteamInputPollList, ESPMode::ThreadSafe> NewPollList = MakeShared<FSteamInputPollList, ESPMode::ThreadSafe>();
+		ActionTable->BuildPollList(ActionSet, Layers, *NewPollList);
+		PollList = NewPollList;
+	}
+
+	if (State.PollList != PollList)
+	{
+		State.PollList = PollList;
+		InputSource->SetPollList(State.Handle, PollList);
+	}
+}
+
+const FSteamInputHistory* FSteamInputController::FindInputHistory(const InputHandle_t ControllerHandle) const
+{
+	const FControllerState* State = ControllerStates.Find(ControllerHandle);
+	return State && State->History.IsEnabled() ? &State->History : nullptr;
+}
+
+const FSteamInputActionEdges* FSteamInputController::FindActionEdges(const InputHandle_t ControllerHandle) const
+{
+	const FControllerState* State = ControllerStates.Find(ControllerHandle);
+	return State ? &State->Edges : nullptr;
+}
+
+const FSteamInputMotion* FSteamInputController::FindMotion(const InputHandle_t ControllerHandle) const
+{
+	const FControllerState* State = ControllerStates.Find(ControllerHandle);
+	return State && MotionSampler.IsValid() ? &State->Motion : nullptr;
 }
 
 void FSteamInputController::SendControllerEvents()
 {
-	if (!bControllerInitialized || !SteamInput())
+	STEAM_TRACE_SCOPE(SteamInput_SendControllerEvents);
+
+	//replays keep running without Steam, for headless automation
+	if (!IsGamepadAttached())
 	{
 		return;
 	}
+
+	//answers memoized during the previous frame may be stale now
+	FSteamInputQueryCache::Get().Invalidate();
 	
+	UpdateActionTable();
+	UpdateSampler();
+	AnalogChangeThreshold = GetDefault<USteamInputSettings>()->AnalogChangeThreshold;
+	++FrameSampleIndex;
+	Recorder.RecordFrame();
+	FlightRecorder.Update(ActionTable);
+	FlightRecorder.RecordFrame();
+
+	//action events are reported from within RunFrame, pull them now rather than waiting for the next callback pump.
+	//a worker thread pump runs frames out of step with the game thread, polling needs one of its own then
+	const bool bPollsOnGameThread = !Sampler.IsValid() && FSteamCoreModule::Get().IsPumpingOnWorkerThread();
+	if (bActionEventsEnabled || InputSource->ProvidesSamples() || bPollsOnGameThread)
+	{
+		InputSource->RunFrame();
+	}
+
 	InputHandle_t Controllers[STEAM_INPUT_MAX_COUNT];
-	const int32 ControllerCount = SteamInput()->GetConnectedControllers(Controllers);
+	const int32 ControllerCount = InputSource->GetConnectedControllers(Controllers);
 	
 	UpdateControllerState(Controllers, ControllerCount);
+	UpdateLateLatch();
+
+	//without the sampler Steam's frame ran in the callback pump, motion is read once per rendered frame
+	if (MotionSampler.IsValid() && !Sampler.IsValid())
+	{
+		MotionSampler->Sample(Controllers, ControllerCount);
+	}
+
+	FrameEventsEmitted = 0;
+	FrameAnalogEventsSuppressed = 0;
 
 	for (auto& ControllerState : ControllerStates)
 	{
 		ProcessControllerInput(ControllerState.Key, ControllerState.Value);
 	}
+
+	//everything sampled from here on is motion the simulation has not seen, the render thread adds it to the view
+	if (LateLatch.IsValid())
+	{
+		LateLatch->LatchGameThread();
+	}
+
+	STEAM_INPUT_SET_COUNTER(ConnectedControllers, ControllerCount);
+	STEAM_INPUT_INC_COUNTER(EventsEmitted, FrameEventsEmitted);
+	STEAM_INPUT_INC_COUNTER(AnalogEventsSuppressed, FrameAnalogEventsSuppressed);
 }
 
 void FSteamInputController::SetChannelValue(const int32 ControllerId, const FForceFeedbackChannelType ChannelType, const float Value)
 {
-	if (ChannelType != FForceFeedbackChannelType::LEFT_LARGE && ChannelType != FForceFeedbackChannelType::RIGHT_LARGE)
+	if (ControllerId < 0 || ControllerId >= STEAM_INPUT_MAX_COUNT)
 	{
 		return;
 	}
 
-	if (ControllerId >= 0 && ControllerId < STEAM_INPUT_MAX_COUNT)
+	//only the one channel changes, the others keep what was requested before
+	FForceFeedbackValues Values = RequestedVibration[ControllerId];
+	switch (ChannelType)
 	{
-		FForceFeedbackValues Values;
-		if (ChannelType == FForceFeedbackChannelType::LEFT_LARGE)
-		{
-			Values.LeftLarge = Value;
-		}
-		else
-		{
-			Values.RightLarge = Value;
-		}
-
-		SetVibration(ControllerId, Values);
+	case FForceFeedbackChannelType::LEFT_LARGE:
+		Values.LeftLarge = Value;
+		break;
+	case FForceFeedbackChannelType::LEFT_SMALL:
+		Values.LeftSmall = Value;
+		break;
+	case FForceFeedbackChannelType::RIGHT_LARGE:
+		Values.RightLarge = Value;
+		break;
+	case FForceFeedbackChannelType::RIGHT_SMALL:
+		Values.RightSmall = Value;
+		break;
+	default:
+		return;
 	}
+
+	SetVibration(ControllerId, Values);
 }
 
 void FSteamInputController::SetChannelValues(const int32 ControllerId, const FForceFeedbackValues& Values)
 {
-	if (ControllerId >= 0 && ControllerId < STEAM_INPUT_MAX_COUNT)
-	{
-		SetVibration(ControllerId, Values);
-	}
+	SetVibration(ControllerId, Values);
 }
 
 void FSteamInputController::SetMessageHandler(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler)
@@ -86,7 +500,7 @@ void FSteamInputController::SetMessageHandler(const TSharedRef<FGenericApplicati
 
 bool FSteamInputController::IsGamepadAttached() const
 {
-	return bControllerInitialized && SteamInput();
+	return (bControllerInitialized && SteamInput()) || InputSource->ProvidesSamples();
 }
 
 bool FSteamInputController::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar)
@@ -94,29 +508,117 @@ bool FSteamInputController::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevic
 	return false;
 }
 
-void FSteamInputController::SetVibration(const int32 ControllerId, const FForceFeedbackValues& Values) const
+void FSteamInputController::SetVibration(const int32 ControllerId, const FForceFeedbackValues& Values)
 {
-	const InputHandle_t ControllerHandle = SteamInput()->GetControllerForGamepadIndex(ControllerId);
-	if (!ControllerHandle || !IsGamepadAttached())
+	if (ControllerId < 0 || ControllerId >= STEAM_INPUT_MAX_COUNT)
 	{
 		return;
 	}
 
-	//TODO: Don't use legacy functions
-	if (Values.LeftLarge > 0.0f)
+	RequestedVibration[ControllerId] = Values;
+	RequestedVibrationMask |= 1u << ControllerId;
+}
+
+void FSteamInputController::SetTriggerVibration(const int32 ControllerId, const float LeftTrigger, const float RightTrigger)
+{
+	if (ControllerId < 0 || ControllerId >= STEAM_INPUT_MAX_COUNT)
 	{
-		SteamInput()->Legacy_TriggerHapticPulse(ControllerHandle, k_ESteamControllerPad_Left, static_cast<unsigned short>(Values.LeftLarge * 4000.0f));
+		return;
 	}
 
-	if (Values.RightLarge > 0.0f)
+	RequestedTriggerVibration[ControllerId] = FVector2f(LeftTrigger, RightTrigger);
+	RequestedVibrationMask |= 1u << ControllerId;
+}
+
+void FSteamInputController::SetDeviceProperty(const int32 ControllerId, const FInputDeviceProperty* Property)
+{
+	if (!Property || Property->Name != FInputDeviceTriggerVibrationProperty::PropertyName() || ControllerId < 0 || ControllerId >= STEAM_INPUT_MAX_COUNT)
 	{
-		SteamInput()->Legacy_TriggerHapticPulse(ControllerHandle, k_ESteamControllerPad_Right, static_cast<unsigned short>(Values.RightLarge * 4000.0f));
+		return;
+	}
+
+	//amplitudes go up to 8, the affected triggers keep the rest of what was requested
+	const FInputDeviceTriggerVibrationProperty& Vibration = *static_cast<const FInputDeviceTriggerVibrationProperty*>(Property);
+	const float Strength = FMath::Clamp(Vibration.VibrationAmplitude / 8.0f, 0.0f, 1.0f);
+
+	FVector2f Triggers = RequestedTriggerVibration[ControllerId];
+	if (EnumHasAnyFlags(Vibration.AffectedTriggers, EInputDeviceTriggerMask::Left))
+	{
+		Triggers.X = Strength;
+	}
+	if (EnumHasAnyFlags(Vibration.AffectedTriggers, EInputDeviceTriggerMask::Right))
+	{
+		Triggers.Y = Strength;
+	}
+
+	SetTriggerVibration(ControllerId, Triggers.X, Triggers.Y);
+}
+
+void FSteamInputController::FlushVibration()
+{
+	if (RequestedVibrationMask == 0)
+	{
+		return;
+	}
+
+	const uint32 Mask = RequestedVibrationMask;
+	RequestedVibrationMask = 0;
+
+	if (!HapticPlayer.IsValid())
+	{
+		return;
+	}
+
+	for (int32 ControllerId = 0; ControllerId < STEAM_INPUT_MAX_COUNT; ++ControllerId)
+	{
+		if (!(Mask & (1u << ControllerId)))
+		{
+			continue;
+		}
+
+		const InputHandle_t ControllerHandle = FSteamInputQueryCache::Get().GetControllerForGamepadIndex(ControllerId);
+		FControllerState* State = ControllerHandle ? ControllerStates.Find(ControllerHandle) : nullptr;
+		if (!State)
+		{
+			continue;
+		}
+
+		//channels the controller can't play are gone after folding, changes to them never reach Steam
+		const FSteamInputHapticCapabilities Capabilities = FSteamInputHapticCapabilities::Get(State->InputType);
+		const FSteamInputMotorSpeeds Speeds = Capabilities.ToMotorSpeeds(RequestedVibration[ControllerId], RequestedTriggerVibration[ControllerId]);
+		if (!Capabilities.bRumble || State->VibeValues == Speeds)
+		{
+			continue;
+		}
+
+		State->VibeValues = Speeds;
+		HapticPlayer->SetBaseSpeeds(ControllerHandle, Capabilities, Speeds);
+	}
+}
+
+void FSteamInputController::PlayHapticEnvelope(const InputHandle_t Controller, const TSharedRef<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe>& Envelope,
+	const float Strength, const bool bLoop)
+{
+	const FControllerState* State = ControllerStates.Find(Controller);
+	if (HapticPlayer.IsValid() && State)
+	{
+		HapticPlayer->Play(Controller, FSteamInputHapticCapabilities::Get(State->InputType), Envelope, Strength, bLoop);
+	}
+}
+
+void FSteamInputController::StopHapticEnvelope(const InputHandle_t Controller)
+{
+	if (HapticPlayer.IsValid())
+	{
+		HapticPlayer->StopEnvelope(Controller);
 	}
 }
 
 void FSteamInputController::ProcessControllerInput(const FInputHandle& ControllerHandle,
                                                    FControllerState& State)
 {
+	STEAM_TRACE_SCOPE(SteamInput_ProcessControllerInput);
+
 	static FName SystemName(TEXT("SteamController"));
 	static FString ControllerName(TEXT("SteamController"));
 	FInputDeviceScope InputScope{this, SystemName, static_cast<int32>(GetTypeHash(ControllerHandle.ControllerID)), ControllerName};
@@ -125,110 +627,418 @@ void FSteamInputController::ProcessControllerInput(const FInputHandle& Controlle
 	FInputDeviceId DeviceId;
 	GetPlatformUserAndDevice(ControllerHandle, UserId, DeviceId);
 	
-	SteamInput()->ActivateActionSet(ControllerHandle, USteamInputFunctionLibrary::GetActionSetForController(DeviceId));
+	{
+		STEAM_INPUT_SCOPE_CYCLE_COUNTER(ApplyActionSets);
+
+		const InputActionSetHandle_t ActionSet = USteamInputFunctionLibrary::GetActionSetForController(DeviceId);
+		const auto ActionLayers = USteamInputFunctionLibrary::GetActionLayersForController(DeviceId);
+		const TConstArrayView<InputActionSetHandle_t> Layers = ActionLayers ? TConstArrayView<InputActionSetHandle_t>(*ActionLayers) : TConstArrayView<InputActionSetHandle_t>();
 
-	SteamInput()->DeactivateAllActionSetLayers(ControllerHandle);
-	if (const auto ActionLayers = USteamInputFunctionLibrary::GetActionLayersForController(DeviceId))
-		for (const auto ActionLayer : *ActionLayers)
+		//replayed and scripted controllers are not Steam's, their handles may even collide with real ones
+		const bool bLiveSource = InputSource == FSteamInputLiveSource::Get();
+
+		//the sampler thread polls while it runs, activating from here would race with its polling
+		if (bLiveSource && Sampler.IsValid())
 		{
-			SteamInput()->ActivateActionSetLayer(ControllerHandle, ActionLayer);
+			Sampler->SetActionSets(ControllerHandle, ActionSet, Layers);
 		}
-	
-	for (auto& Key : GetDefault<USteamInputSettings>()->Keys)
+		else if (ISteamInput* Input = bLiveSource ? SteamInput() : nullptr)
+		{
+			STEAM_IPC_CALL(Input, Input, ActivateActionSet, ControllerHandle, ActionSet);
+
+			STEAM_IPC_CALL(Input, Input, DeactivateAllActionSetLayers, ControllerHandle);
+			for (const InputActionSetHandle_t ActionLayer : Layers)
+			{
+				STEAM_IPC_CALL(Input, Input, ActivateActionSetLayer, ControllerHandle, ActionLayer);
+			}
+		}
+
+		if (ActionTable->HasActionSets())
+		{
+			UpdatePollList(ActionSet, Layers, State);
+		}
+
+		if (Recorder.IsRecording())
+		{
+			Recorder.RecordActionSets(ControllerHandle, ActionSet, Layers);
+		}
+	}
+
+	PendingSamples.Reset();
+	bool bSettleFilter = false;
+	if (InputSource->ProvidesSamples())
+	{
+		InputSource->ConsumeSamples(*ActionTable, ControllerHandle, PendingSamples);
+	}
+	else if (Sampler.IsValid())
 	{
-		const FName& ActionName = Key.ActionName;
+		STEAM_INPUT_SCOPE_CYCLE_COUNTER(ConsumeSamples);
 
-		if (!Key.bHandleValid)
+		//dispatch every sample taken since the last frame so short presses between frames are not lost
+		Sampler->ConsumeSamples(ControllerHandle, State.LastSampleIndex, PendingSamples);
+	}
+	else if (bActionEventsEnabled)
+	{
+		FScopeLock Lock(&EventLock);
+		if (FEventState* EventState = EventStates.Find(ControllerHandle))
 		{
-			continue;
+			PendingSamples.Append(EventState->Pending);
+			EventState->Pending.Reset();
 		}
+		bSettleFilter = PendingSamples.IsEmpty() && AnalogFilter.IsEnabled();
+	}
+	else
+	{
+		FSteamInputSample& Sample = PendingSamples.AddDefaulted_GetRef();
+		Sample.Init(*ActionTable);
+		Sample.SampleIndex = FrameSampleIndex;
+		Sample.Timestamp = FPlatformTime::Seconds();
+		InputSource->PollSample(*ActionTable, ControllerHandle, Sample);
+	}
 
-		switch (Key.KeyType)
+	STEAM_INPUT_SCOPE_CYCLE_COUNTER(Dispatch);
+	State.Edges.BeginFrame(GFrameCounter);
+	for (FSteamInputSample& Sample : PendingSamples)
+	{
+		if (Recorder.IsRecording() && Sample.TableRevision == ActionTable->Revision)
 		{
-		case EKeyType::Button:
-			ProcessDigitalAction(UserId, DeviceId, ControllerHandle, ActionName, Key, State);
-			break;
-		default:
-			ProcessAnalogAction(UserId, DeviceId, ControllerHandle, ActionName, Key, State);
-			break;
+			Recorder.RecordSample(ControllerHandle, *ActionTable, Sample);
 		}
+		FlightRecorder.RecordSample(ControllerHandle, Sample);
+
+		//recordings keep the raw values so a replay goes through the filters again
+		if (AnalogFilter.IsEnabled() && Sample.TableRevision == ActionTable->Revision)
+		{
+			AnalogFilter.Apply(Sample, State.FilterState);
+		}
+
+		ProcessSample(UserId, DeviceId, Sample, State);
+	}
+
+	if (bSettleFilter)
+	{
+		SettleAnalogFilter(UserId, DeviceId, State);
+	}
+
+	//holds complete with time rather than with a change, samples may be a frame or more apart
+	if (GestureDetector.IsEnabled())
+	{
+		TickGestures(UserId, DeviceId, State);
+	}
+
+	DispatchMouseDeltas(UserId, DeviceId, State);
+
+	if (MotionSampler.IsValid())
+	{
+		ProcessMotion(UserId, DeviceId, State);
 	}
 }
 
-void FSteamInputController::ProcessDigitalAction(const FPlatformUserId UserID, const FInputDeviceId DeviceId, const FInputHandle& ControllerHandle,
-	const FName& ActionName, const FSteamInputAction& ActionData, FControllerState& State) const
+void FSteamInputController::ProcessMotion(const FPlatformUserId UserID, const FInputDeviceId DeviceId, FControllerState& State)
 {
+	const FVector PreviousDelta = State.Motion.RotationDelta;
+	if (!MotionSampler->ConsumeMotion(State.Handle, State.Motion) || UserID == PLATFORMUSERID_NONE || DeviceId == INPUTDEVICEID_NONE)
+	{
+		return;
+	}
+
+	const FSteamInputMotion& Motion = State.Motion;
+
+	//the engine motion keys expect radians, and acceleration without gravity
+	const FVector Gravity = Motion.Orientation.UnrotateVector(FVector::DownVector);
+	MessageHandler->OnMotionDetected(FMath::DegreesToRadians(Motion.Orientation.Euler()), FMath::DegreesToRadians(Motion.RotationRate), Gravity,
+		Motion.Acceleration - Gravity, UserID, DeviceId);
+	++FrameEventsEmitted;
+
+	//deltas are only dispatched while the controller turns, and once more to report it stopped
+	static const FName GyroKeyX = USteamInputSettings::GetXAxisName(USteamInputSettings::GyroKeyName);
+	static const FName GyroKeyY = USteamInputSettings::GetYAxisName(USteamInputSettings::GyroKeyName);
+	if (Motion.RotationDelta.Z != 0.0 || PreviousDelta.Z != 0.0)
+	{
+		MessageHandler->OnControllerAnalog(GyroKeyX, UserID, DeviceId, static_cast<float>(Motion.RotationDelta.Z));
+		++FrameEventsEmitted;
+	}
+	if (Motion.RotationDelta.X != 0.0 || PreviousDelta.X != 0.0)
+	{
+		MessageHandler->OnControllerAnalog(GyroKeyY, UserID, DeviceId, static_cast<float>(Motion.RotationDelta.X));
+		++FrameEventsEmitted;
+	}
+}
+
+void FSteamInputController::ProcessSample(const FPlatformUserId UserID, const FInputDeviceId DeviceId, const FSteamInputSample& Sample,
+	FControllerState& State) const
+{
+	//sampled before the action table was rebuilt, indices no longer line up
+	if (Sample.TableRevision != ActionTable->Revision)
+	{
+		return;
+	}
+
+	State.History.Record(*ActionTable, Sample);
+	State.Edges.Accumulate(State.LastSample.Digital, Sample.Digital);
+
+	//nobody to dispatch to, the sample still becomes the baseline so its edges are not accumulated again by the next one
 	if (UserID == PLATFORMUSERID_NONE || DeviceId == INPUTDEVICEID_NONE)
 	{
+		State.LastSample = Sample;
 		return;
 	}
-	
-	const auto [bState, bActive] = SteamInput()->GetDigitalActionData(ControllerHandle, ActionData.CachedHandle);
 
-	const bool bPreviousState = State.DigitalStatusMap.FindRef(ActionName);
+	{
+		STEAM_INPUT_SCOPE_CYCLE_COUNTER(Digital);
+		for (int32 Index = 0; Index < ActionTable->DigitalActions.Num(); ++Index)
+		{
+			ProcessDigitalAction(UserID, DeviceId, Index, Sample, State);
+		}
+	}
+
+	if (GestureDetector.IsEnabled())
+	{
+		ProcessGestures(UserID, DeviceId, Sample, State);
+	}
 
-	const double CurrentTime = FPlatformTime::Seconds();
+	{
+		STEAM_INPUT_SCOPE_CYCLE_COUNTER(Analog);
+		for (int32 Index = 0; Index < ActionTable->AnalogActions.Num(); ++Index)
+		{
+			ProcessAnalogAction(UserID, DeviceId, Index, Sample, State);
+		}
+	}
+
+	State.LastSample = Sample;
+}
+
+void FSteamInputController::ProcessDigitalAction(const FPlatformUserId UserID, const FInputDeviceId DeviceId, const int32 ActionIndex,
+	const FSteamInputSample& Sample, FControllerState& State) const
+{
+	const FName& ActionName = ActionTable->DigitalActions[ActionIndex].ActionName;
+	const bool bState = Sample.Digital.Get(ActionIndex);
+	const bool bPreviousState = State.LastSample.Digital.Get(ActionIndex);
+	const double Time = Sample.Timestamp;
 
 	if (!bPreviousState && bState)
 	{
 		MessageHandler->OnControllerButtonPressed(ActionName, UserID, DeviceId, false);
-		UpdateKeyRepeatTiming(ActionName, State, CurrentTime);
+		TraceControllerEvent(ESteamInputTraceEvent::Pressed, ActionName, UserID, DeviceId, Time);
+		OnEventEmitted(ActionName, Sample, State, false, ActionIndex);
+		UpdateKeyRepeatTiming(ActionIndex, State, Time);
 	}
 	else if (bPreviousState && !bState)
 	{
 		MessageHandler->OnControllerButtonReleased(ActionName, UserID, DeviceId, false);
-		State.DigitalRepeatTimeMap.Remove(ActionName);
+		TraceControllerEvent(ESteamInputTraceEvent::Released, ActionName, UserID, DeviceId, Time);
+		OnEventEmitted(ActionName, Sample, State, false, ActionIndex);
+		State.DigitalRepeatTimes[ActionIndex] = 0.0;
 	}
-	else if (bPreviousState && bState && ShouldProcessKeyRepeat(ActionName, State, CurrentTime))
+	else if (bPreviousState && bState && ShouldProcessKeyRepeat(ActionIndex, State, Time))
 	{
 		MessageHandler->OnControllerButtonPressed(ActionName, UserID, DeviceId, true);
-		UpdateKeyRepeatTiming(ActionName, State, CurrentTime);
+		TraceControllerEvent(ESteamInputTraceEvent::Repeated, ActionName, UserID, DeviceId, Time);
+		OnEventEmitted(ActionName, Sample, State, false, ActionIndex);
+		UpdateKeyRepeatTiming(ActionIndex, State, Time);
 	}
+}
+
+void FSteamInputController::ProcessAnalogAction(const FPlatformUserId UserID, const FInputDeviceId DeviceId, const int32 ActionIndex,
+	const FSteamInputSample& Sample, FControllerState& State) const
+{
+	const FSteamInputActionTable::FAnalogAction& Action = ActionTable->AnalogActions[ActionIndex];
+	const FVector2f& Value = Sample.Analog[ActionIndex];
+	FVector2f& Dispatched = State.DispatchedAnalog[ActionIndex];
+	const double Time = Sample.Timestamp;
+
+	switch (Action.KeyType)
+	{
+	case EKeyType::MouseInput:
+		//every sample holds the motion since the one before, summed up and dispatched once per frame in DispatchMouseDeltas
+		State.MouseDeltas[ActionIndex] += Value;
+		break;
+	case EKeyType::Analog:
+		if (ShouldDispatchAxis(Dispatched.X, Value.X))
+		{
+			Dispatched.X = Value.X;
+			MessageHandler->OnControllerAnalog(Action.ActionName, UserID, DeviceId, Value.X);
+			TraceControllerEvent(ESteamInputTraceEvent::Axis, Action.ActionName, UserID, DeviceId, Time, Value.X);
+			OnEventEmitted(Action.ActionName, Sample, State, true, ActionIndex);
+		}
+		else
+		{
+			++FrameAnalogEventsSuppressed;
+		}
+		break;
+	case EKeyType::Joystick:
+		if (ShouldDispatchAxis(Dispatched.X, Value.X))
+		{
+			Dispatched.X = Value.X;
+			MessageHandler->OnControllerAnalog(Action.XAxisName, UserID, DeviceId, Value.X);
+			TraceControllerEvent(ESteamInputTraceEvent::Axis, Action.XAxisName, UserID, DeviceId, Time, Value.X);
+			OnEventEmitted(Action.XAxisName, Sample, State, true, ActionIndex);
+		}
+		else
+		{
+			++FrameAnalogEventsSuppressed;
+		}
 
-	State.DigitalStatusMap.Add(ActionName, bState);
+		if (ShouldDispatchAxis(Dispatched.Y, Value.Y))
+		{
+			Dispatched.Y = Value.Y;
+			MessageHandler->OnControllerAnalog(Action.YAxisName, UserID, DeviceId, Value.Y);
+			TraceControllerEvent(ESteamInputTraceEvent::Axis, Action.YAxisName, UserID, DeviceId, Time, Value.Y);
+			OnEventEmitted(Action.YAxisName, Sample, State, true, ActionIndex);
+		}
+		else
+		{
+			++FrameAnalogEventsSuppressed;
+		}
+		break;
+	default:
+		break;
+	}
 }
 
-void FSteamInputController::ProcessAnalogAction(const FPlatformUserId UserID, const FInputDeviceId DeviceId, const FInputHandle& ControllerHandle,
-	const FName& ActionName, const FSteamInputAction& ActionData, FControllerState& State) const
+bool FSteamInputController::ShouldDispatchAxis(const float DispatchedValue, const float Value) const
 {
-	const InputAnalogActionData_t ActionState = SteamInput()->GetAnalogActionData(ControllerHandle, ActionData.CachedHandle);
+	if (DispatchedValue == Value)
+	{
+		return false;
+	}
 
-	const ControllerAnalogActionData_t PreviousState = State.AnalogStatusMap.FindRef(ActionName);
+	//rest and full deflection are always reported exactly, filtered values may only approach them in small steps
+	return FMath::Abs(Value - DispatchedValue) > AnalogChangeThreshold || Value == 0.0f || FMath::Abs(Value) >= 1.0f;
+}
 
+void FSteamInputController::SettleAnalogFilter(const FPlatformUserId UserID, const FInputDeviceId DeviceId, FControllerState& State)
+{
+	if (State.LastSample.TableRevision != ActionTable->Revision)
+	{
+		return;
+	}
+
+	//PendingSamples is empty on frames without events, reuse it as scratch so settling doesn't allocate
+	FSteamInputSample& Sample = PendingSamples.AddDefaulted_GetRef();
+	Sample = State.LastSample;
+	if (!AnalogFilter.Settle(Sample, State.FilterState, FPlatformTime::Seconds()))
+	{
+		return;
+	}
+
+	State.LastSample.Analog = Sample.Analog;
 	if (UserID == PLATFORMUSERID_NONE || DeviceId == INPUTDEVICEID_NONE)
 	{
 		return;
 	}
 
-	switch (ActionData.KeyType)
+	STEAM_INPUT_SCOPE_CYCLE_COUNTER(Analog);
+	for (int32 Index = 0; Index < ActionTable->AnalogActions.Num(); ++Index)
 	{
-	case EKeyType::Analog:
+		//MouseInput deltas did not continue, only the held axes get dispatched
+		if (ActionTable->AnalogActions[Index].KeyType != EKeyType::MouseInput)
 		{
-			if (PreviousState.x != ActionState.x)
-			{
-				MessageHandler->OnControllerAnalog(ActionName, UserID, DeviceId, ActionState.x);
-			}
+			ProcessAnalogAction(UserID, DeviceId, Index, Sample, State);
 		}
-		break;
-	case EKeyType::MouseInput:
-	case EKeyType::Joystick:
-		if (PreviousState.x != ActionState.x)
+	}
+}
+
+void FSteamInputController::ProcessGestures(const FPlatformUserId UserID, const FInputDeviceId DeviceId, const FSteamInputSample& Sample,
+	FControllerState& State) const
+{
+	STEAM_INPUT_SCOPE_CYCLE_COUNTER(Gestures);
+
+	GestureDetector.Evaluate(Sample, State.LastSample.Digital, State.GestureState);
+	DispatchGestures(UserID, DeviceId, Sample.Timestamp, State);
+}
+
+void FSteamInputController::TickGestures(const FPlatformUserId UserID, const FInputDeviceId DeviceId, FControllerState& State) const
+{
+	if (State.GestureState.Holding.IsEmpty() || State.LastSample.TableRevision != ActionTable->Revision
+		|| UserID == PLATFORMUSERID_NONE || DeviceId == INPUTDEVICEID_NONE)
+	{
+		return;
+	}
+
+	STEAM_INPUT_SCOPE_CYCLE_COUNTER(Gestures);
+
+	const double Time = FPlatformTime::Seconds();
+	GestureDetector.Tick(State.LastSample.Digital, Time, State.GestureState);
+	DispatchGestures(UserID, DeviceId, Time, State);
+}
+
+void FSteamInputController::DispatchGestures(const FPlatformUserId UserID, const FInputDeviceId DeviceId, const double Time,
+	const FControllerState& State) const
+{
+	//gestures are events rather than held state, bindings see the press and the release within the same frame
+	for (const int32 GestureIndex : State.GestureState.Recognized)
+	{
+		const FName& GestureName = GestureDetector.GetGestureName(GestureIndex);
+		MessageHandler->OnControllerButtonPressed(GestureName, UserID, DeviceId, false);
+		TraceControllerEvent(ESteamInputTraceEvent::Pressed, GestureName, UserID, DeviceId, Time);
+		MessageHandler->OnControllerButtonReleased(GestureName, UserID, DeviceId, false);
+		TraceControllerEvent(ESteamInputTraceEvent::Released, GestureName, UserID, DeviceId, Time);
+		FrameEventsEmitted += 2;
+	}
+}
+
+void FSteamInputController::DispatchMouseDeltas(const FPlatformUserId UserID, const FInputDeviceId DeviceId, FControllerState& State)
+{
+	if (UserID == PLATFORMUSERID_NONE || DeviceId == INPUTDEVICEID_NONE || State.LastSample.TableRevision != ActionTable->Revision)
+	{
+		return;
+	}
+
+	STEAM_INPUT_SCOPE_CYCLE_COUNTER(Analog);
+
+	//the sum is dispatched whenever there was motion, and once more as 0 when it stopped
+	const double Time = State.LastSample.Timestamp;
+	for (int32 Index = 0; Index < State.MouseDeltas.Num(); ++Index)
+	{
+		const FSteamInputActionTable::FAnalogAction& Action = ActionTable->AnalogActions[Index];
+		if (Action.KeyType != EKeyType::MouseInput)
 		{
-			const FName XAxisName = USteamInputSettings::GetXAxisName(ActionName);
-			MessageHandler->OnControllerAnalog(XAxisName, UserID, DeviceId, ActionState.x);
+			continue;
 		}
-			
-		if (PreviousState.y != ActionState.y)
+
+		const FVector2f Delta = State.MouseDeltas[Index];
+		const FVector2f PreviousDelta = State.DispatchedMouseDeltas[Index];
+
+		if (Delta.X != 0.0f || PreviousDelta.X != 0.0f)
 		{
-			const FName YAxisName = USteamInputSettings::GetYAxisName(ActionName);
-			MessageHandler->OnControllerAnalog(YAxisName, UserID, DeviceId, ActionState.y);
+			MessageHandler->OnControllerAnalog(Action.XAxisName, UserID, DeviceId, Delta.X);
+			TraceControllerEvent(ESteamInputTraceEvent::Axis, Action.XAxisName, UserID, DeviceId, Time, Delta.X);
+			OnEventEmitted(Action.XAxisName, State.LastSample, State, true, Index);
 		}
-		break;
-	default:
-		break;
+		else
+		{
+			++FrameAnalogEventsSuppressed;
+		}
+
+		if (Delta.Y != 0.0f || PreviousDelta.Y != 0.0f)
+		{
+			MessageHandler->OnControllerAnalog(Action.YAxisName, UserID, DeviceId, Delta.Y);
+			TraceControllerEvent(ESteamInputTraceEvent::Axis, Action.YAxisName, UserID, DeviceId, Time, Delta.Y);
+			OnEventEmitted(Action.YAxisName, State.LastSample, State, true, Index);
+		}
+		else
+		{
+			++FrameAnalogEventsSuppressed;
+		}
+
+		State.DispatchedMouseDeltas[Index] = Delta;
+		State.MouseDeltas[Index] = FVector2f::ZeroVector;
 	}
+}
+
+void FSteamInputController::OnEventEmitted(const FName& Key, const FSteamInputSample& Sample, const FControllerState& State, const bool bAnalog,
+	const int32 ActionIndex) const
+{
+	++FrameEventsEmitted;
 
-	State.AnalogStatusMap.Add(ActionName, ActionState);
+	FSteamInputLatencyTracker& LatencyTracker = FSteamInputLatencyTracker::Get();
+	if (LatencyTracker.IsEnabled())
+	{
+		//measure from the actual change when the source knows it, the sample only tells when the change was seen
+		const double ChangeTime = InputSource->GetChangeTime(State.Handle, bAnalog, ActionIndex);
+		LatencyTracker.Stamp(Key, Sample.SampleIndex, ChangeTime > 0.0 && ChangeTime <= Sample.Timestamp ? ChangeTime : Sample.Timestamp);
+	}
 }
 
 void FSteamInputController::UpdateControllerState(const InputHandle_t* ConnectedControllers, const int32 Count)
@@ -246,6 +1056,16 @@ void FSteamInputController::UpdateControllerState(const InputHandle_t* Connected
 			}
 		case FControllerState::Disconnected:
 			{
+				Recorder.RecordConnection(It.Key(), false);
+				if (HapticPlayer.IsValid())
+				{
+					HapticPlayer->RemoveController(It.Key());
+				}
+				if (MotionSampler.IsValid())
+				{
+					MotionSampler->RemoveController(It.Key());
+				}
+				InputSource->SetPollList(It.Key(), nullptr);
 				It.RemoveCurrent();
 				continue;
 			}
@@ -262,7 +1082,17 @@ void FSteamInputController::UpdateControllerState(const InputHandle_t* Connected
 		}
 		else
 		{
-			ControllerStates.Add(ConnectedControllers[i]).ConnectionState = FControllerState::Reconnect;
+			FControllerState& NewState = ControllerStates.Add(ConnectedControllers[i]);
+			NewState.Handle = ConnectedControllers[i];
+			NewState.ConnectionState = FControllerState::Reconnect;
+			ResetControllerState(NewState);
+
+			//looked up once per connection, the haptics capabilities depend on it
+			if (ISteamInput* Input = bControllerInitialized ? SteamInput() : nullptr)
+			{
+				NewState.InputType = STEAM_IPC_CALL(Input, Input, GetInputTypeForHandle, NewState.Handle);
+			}
+			Recorder.RecordConnection(NewState.Handle, true);
 		}
 	}
 }
@@ -297,18 +1127,18 @@ void FSteamInputController::GetPlatformUserAndDevice(const FInputHandle InputHan
 	}
 }
 
-bool FSteamInputController::ShouldProcessKeyRepeat(const FName& ActionName, FControllerState& State,
+bool FSteamInputController::ShouldProcessKeyRepeat(const int32 ActionIndex, const FControllerState& State,
                                                    const double CurrentTime) const
 {
-	const double* NextRepeatTime = State.DigitalRepeatTimeMap.Find(ActionName);
-	return NextRepeatTime && CurrentTime >= *NextRepeatTime;
+	const double NextRepeatTime = State.DigitalRepeatTimes[ActionIndex];
+	return NextRepeatTime > 0.0 && CurrentTime >= NextRepeatTime;
 }
 
-void FSteamInputController::UpdateKeyRepeatTiming(const FName& ActionName, FControllerState& State,
+void FSteamInputController::UpdateKeyRepeatTiming(const int32 ActionIndex, FControllerState& State,
 	const double CurrentTime) const
 {
-	const bool bIsFirstRepeat = !State.DigitalRepeatTimeMap.Contains(ActionName);
+	const bool bIsFirstRepeat = State.DigitalRepeatTimes[ActionIndex] == 0.0;
 	const double DelayToUse = bIsFirstRepeat ? InitialButtonRepeatDelay : ButtonRepeatDelay;
 
-	State.DigitalRepeatTimeMap.Add(ActionName, CurrentTime + DelayToUse);
+	State.DigitalRepeatTimes[ActionIndex] = CurrentTime + DelayToUse;
 }
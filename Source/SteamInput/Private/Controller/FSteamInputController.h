@@ -4,10 +4,26 @@
 
 #include "IInputDevice.h"
 #include "SteamInputTypes.h"
+#include "Controller/SteamInputAnalogFilter.h"
+#include "Controller/SteamInputGestureDetector.h"
+#include "Controller/SteamInputHistory.h"
+#include "Controller/SteamInputSample.h"
+#include "Haptics/SteamInputHapticPlayer.h"
+#include "Recording/SteamInputFlightRecorder.h"
+#include "Recording/SteamInputRecorder.h"
+#include "Containers/StaticArray.h"
 #include "GenericPlatform/IInputInterface.h"
 #include "steam/isteamcontroller.h"
 
-struct FSteamInputAction;
+struct FSteamInputActionTable;
+struct FSteamInputActionEvent;
+struct FSteamInputPollList;
+struct FSteamInputHapticEnvelope;
+class FSteamInputSampler;
+class FSteamInputMotionSampler;
+class FSteamInputLateLatch;
+class FSteamInputLateLatchExtension;
+class ISteamInputSource;
 
 class FSteamInputController : public IInputDevice
 {
@@ -22,21 +38,94 @@ public:
 	virtual bool IsGamepadAttached() const override;
 	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override;
 
-	void SetVibration(int32 ControllerId, const FForceFeedbackValues& Values) const;
+	/// Request force feedback on a controller, requests are merged and sent once at the end of the frame if they changed
+	/// @param ControllerId Gamepad index of the controller
+	void SetVibration(int32 ControllerId, const FForceFeedbackValues& Values);
+	/// Request trigger rumble on a controller, merged and sent along with SetVibration
+	/// @param LeftTrigger Strength of the left trigger motor from 0.0 to 1.0
+	/// @param RightTrigger Strength of the right trigger motor from 0.0 to 1.0
+	void SetTriggerVibration(int32 ControllerId, float LeftTrigger, float RightTrigger);
+	virtual void SetDeviceProperty(int32 ControllerId, const FInputDeviceProperty* Property) override;
+
+	/// Play a precomputed envelope on a controller from the haptics thread, on top of the regular force feedback
+	/// @param Controller Steam handle of the controller
+	/// @param Strength Scale applied to the envelope
+	/// @param bLoop Restart the envelope once it ended, until StopHapticEnvelope is called
+	void PlayHapticEnvelope(InputHandle_t Controller, const TSharedRef<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe>& Envelope, float Strength = 1.0f, bool bLoop = false);
+	void StopHapticEnvelope(InputHandle_t Controller);
+
+	/** Action table samples are currently taken and dispatched with */
+	TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> GetActionTable() const {return ActionTable;}
+	/** The background sampler, only valid while the sampling mode is FixedRate */
+	const FSteamInputSampler* GetSampler() const {return Sampler.Get();}
+	/** Input history of a connected controller, null if the controller is unknown or the history is disabled */
+	const FSteamInputHistory* FindInputHistory(InputHandle_t ControllerHandle) const;
+	/** Digital actions of a connected controller down, pressed and released during the last frame, null if the controller is unknown */
+	const FSteamInputActionEdges* FindActionEdges(InputHandle_t ControllerHandle) const;
+	/** Motion of a connected controller as of the last frame, null if the controller is unknown or motion is disabled */
+	const FSteamInputMotion* FindMotion(InputHandle_t ControllerHandle) const;
+
+	/// Replace where controller state is read from, for scripted input and replays
+	/// @param InSource New source, null restores the live SteamInput() source
+	void SetInputSource(const TSharedPtr<ISteamInputSource, ESPMode::ThreadSafe>& InSource);
+	const TSharedRef<ISteamInputSource, ESPMode::ThreadSafe>& GetInputSource() const {return InputSource;}
+
+	/// Record everything dispatched from now on into a SteamInputRecording file
+	/// @param Filename File to record into, empty for SteamInputRecording::MakeDefaultFilename
+	/// @return false if the file could not be opened
+	bool StartRecording(const FString& Filename);
+	void StopRecording();
+	const FSteamInputRecorder& GetRecorder() const {return Recorder;}
+
+	/// Write the input kept by the flight recorder into a recording
+	/// @param Filename File to write, empty for a new file next to the recordings
+	/// @return Name of the written file, empty if the flight recorder is disabled or empty
+	FString DumpFlightRecorder(const FString& Filename) {return FlightRecorder.Dump(Filename, TEXT("on request"));}
 private:
 	struct FControllerState
 	{
-		/** Analog status for all actions from previous frame, on a -1.0 to 1.0 range */
-		TMap<FName, ControllerAnalogActionData_t> AnalogStatusMap{};
+		/** Steam handle of the controller */
+		InputHandle_t Handle = 0;
+
+		/** State of all actions as of the last dispatched sample, Analog values on a -1.0 to 1.0 range */
+		FSteamInputSample LastSample{};
+
+		/** Digital actions down, pressed and released during the current frame */
+		FSteamInputActionEdges Edges{};
+
+		/** Per digital action, the time at which a held button counts as a "repeated press". 0 while the button is not held */
+		TArray<double> DigitalRepeatTimes{};
+
+		/** Actions polled for the active action set and layers, as handed to the input source */
+		TSharedPtr<const FSteamInputPollList, ESPMode::ThreadSafe> PollList{};
 
-		/** Button status for all actions from previous frame (pressed down or not) */
-		TMap<FName, bool> DigitalStatusMap{};
+		/** Index of the last sample consumed from the fixed rate sampler */
+		uint64 LastSampleIndex = 0;
 
-		/** List of times that if a button is still pressed counts as a "repeated press" */
-		TMap<FName, double> DigitalRepeatTimeMap{};
+		/** Quantized frames of the last dispatched ticks, sized by USteamInputSettings::InputHistoryLength */
+		FSteamInputHistory History{};
 
-		/** Values for force feedback on this controller.  We only consider the LEFT_LARGE channel for SteamControllers */
-		FForceFeedbackValues VibeValues{};
+		/** Per analog action, the MouseInput deltas of every sample dispatched this frame summed up */
+		TArray<FVector2f> MouseDeltas{};
+		/** Per analog action, the MouseInput sums dispatched last frame */
+		TArray<FVector2f> DispatchedMouseDeltas{};
+		/** Per analog action, the Analog and Joystick values last handed to the message handler */
+		TArray<FVector2f> DispatchedAnalog{};
+
+		/** Smoothing history of the analog filter */
+		FSteamInputAnalogFilter::FState FilterState{};
+
+		/** Progress of every gesture */
+		FSteamInputGestureDetector::FState GestureState{};
+
+		/** Type of the controller, decides which force feedback channels it can play */
+		ESteamInputType InputType = k_ESteamInputType_Unknown;
+
+		/** Motion sensors as of the last frame, the rotation delta covers every reading since the frame before */
+		FSteamInputMotion Motion{};
+
+		/** Motor speeds last requested by the engine force feedback, envelopes from the haptic player play on top */
+		FSteamInputMotorSpeeds VibeValues{};
 
 		enum EConnectionState
 		{
@@ -47,20 +136,125 @@ private:
 
 		FControllerState() = default;
 	};
-	
+
 	TMap<FInputHandle, FControllerState> ControllerStates;
 
 	bool bControllerInitialized = false;
 	TSharedRef<FGenericApplicationMessageHandler> MessageHandler;
 	double InitialButtonRepeatDelay = 0.2;
 	double ButtonRepeatDelay = 0.1;
+	/** USteamInputSettings::AnalogChangeThreshold, read once per frame */
+	float AnalogChangeThreshold = 0.0f;
+
+	TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> ActionTable;
+	/** Filters of USteamInputSettings::AnalogFilters, laid out for ActionTable */
+	FSteamInputAnalogFilter AnalogFilter;
+	/** Gestures of USteamInputSettings::Gestures, compiled for ActionTable */
+	FSteamInputGestureDetector GestureDetector;
+	TUniquePtr<FSteamInputSampler> Sampler;
+
+	/** Identifies a combination of action set and layers */
+	struct FPollListKey
+	{
+		InputActionSetHandle_t ActionSet = 0;
+		TArray<InputActionSetHandle_t, TInlineAllocator<4>> Layers;
+
+		bool operator==(const FPollListKey& Other) const {return ActionSet == Other.ActionSet && Layers == Other.Layers;}
+		friend uint32 GetTypeHash(const FPollListKey& Key)
+		{
+			uint32 Hash = GetTypeHash(Key.ActionSet);
+			for (const InputActionSetHandle_t Layer : Key.Layers)
+			{
+				Hash = HashCombineFast(Hash, GetTypeHash(Layer));
+			}
+			return Hash;
+		}
+	};
+
+	/** Poll list of every combination of action set and layers seen since ActionTable was built */
+	TMap<FPollListKey, TSharedPtr<const FSteamInputPollList, ESPMode::ThreadSafe>> PollLists;
+	/** Only valid while bEnableMotion is set, sampled by Sampler while it runs and by the game thread otherwise */
+	TSharedPtr<FSteamInputMotionSampler, ESPMode::ThreadSafe> MotionSampler;
+
+	/** Camera late latch, only valid while bLateLatchCamera is set */
+	TSharedPtr<FSteamInputLateLatch, ESPMode::ThreadSafe> LateLatch;
+	TSharedPtr<FSteamInputLateLatchExtension, ESPMode::ThreadSafe> LateLatchExtension;
+	TSharedRef<ISteamInputSource, ESPMode::ThreadSafe> InputSource;
+
+	struct FEventState
+	{
+		/** State after the newest event */
+		FSteamInputSample Current;
+		/** One sample per event since the last frame */
+		TArray<FSteamInputSample> Pending;
+	};
+
+	/** Whether InputSource reports action events, only touched by the game thread */
+	bool bActionEventsEnabled = false;
+	/** State built from action events, written on whichever thread the source reports them from */
+	FCriticalSection EventLock;
+	TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> EventTable;
+	TMap<InputHandle_t, FEventState> EventStates;
+	uint64 NextEventSampleIndex = 0;
+
+	/** Index given to samples polled on the game thread */
+	uint64 FrameSampleIndex = 0;
+	/** Scratch buffer samples get polled or consumed into, kept around so steady state polling doesn't allocate */
+	TArray<FSteamInputSample> PendingSamples;
+
+	/** Force feedback requested per gamepad index, kept between frames so single channel updates merge into the previous values */
+	TStaticArray<FForceFeedbackValues, STEAM_INPUT_MAX_COUNT> RequestedVibration;
+	/** Trigger rumble requested per gamepad index, left in X and right in Y */
+	TStaticArray<FVector2f, STEAM_INPUT_MAX_COUNT> RequestedTriggerVibration;
+	/** Bit per gamepad index with a request since the last flush */
+	uint32 RequestedVibrationMask = 0;
+	FDelegateHandle EndFrameHandle;
+	/** Sends all vibration, null while Steam Input is not available */
+	TUniquePtr<FSteamInputHapticPlayer> HapticPlayer;
+
+	FSteamInputRecorder Recorder;
+	FSteamInputFlightRecorder FlightRecorder;
+
+	/** Events handed to the message handler and unchanged analog values skipped during the current frame, for STATGROUP_SteamInput */
+	mutable uint32 FrameEventsEmitted = 0;
+	mutable uint32 FrameAnalogEventsSuppressed = 0;
+
+	/// Send the force feedback requested during the frame, one call per controller whose values changed
+	void FlushVibration();
+
+	void UpdateActionTable();
+	void UpdateSampler();
+	/// Create or drop the late latch and pick the controller of the primary user as its target
+	void UpdateLateLatch();
+	void SetActionEventsEnabled(bool bEnabled);
+	void OnActionEvent(const FSteamInputActionEvent& Event);
+	void ResetControllerState(FControllerState& State) const;
+	/// Hand the poll list of the active action set and layers of a controller to the input source, building it on first use
+	void UpdatePollList(InputActionSetHandle_t ActionSet, TConstArrayView<InputActionSetHandle_t> Layers, FControllerState& State);
 
 	void ProcessControllerInput(const FInputHandle& ControllerHandle, FControllerState& State);
-	void ProcessDigitalAction(FPlatformUserId UserID, FInputDeviceId DeviceId, const FInputHandle& ControllerHandle, const FName& ActionName, const FSteamInputAction& ActionData, FControllerState& State) const;
-	void ProcessAnalogAction(FPlatformUserId UserID, FInputDeviceId DeviceId, const FInputHandle& ControllerHandle, const FName& ActionName, const FSteamInputAction& ActionData, FControllerState& State) const;
+	void ProcessSample(FPlatformUserId UserID, FInputDeviceId DeviceId, const FSteamInputSample& Sample, FControllerState& State) const;
+	void ProcessDigitalAction(FPlatformUserId UserID, FInputDeviceId DeviceId, int32 ActionIndex, const FSteamInputSample& Sample, FControllerState& State) const;
+	void ProcessAnalogAction(FPlatformUserId UserID, FInputDeviceId DeviceId, int32 ActionIndex, const FSteamInputSample& Sample, FControllerState& State) const;
+	/// Whether an analog axis moved far enough from its dispatched value to be dispatched again
+	bool ShouldDispatchAxis(float DispatchedValue, float Value) const;
+	/// Step the analog smoothing on a frame without samples and dispatch the axes it moved, action events only arrive on changes
+	void SettleAnalogFilter(FPlatformUserId UserID, FInputDeviceId DeviceId, FControllerState& State);
+	/// Advance the gestures with the digital actions of a sample, recognized gestures are pressed and released right away
+	void ProcessGestures(FPlatformUserId UserID, FInputDeviceId DeviceId, const FSteamInputSample& Sample, FControllerState& State) const;
+	/// Complete the holds that ran out since the last sample, once per frame after the samples were processed
+	void TickGestures(FPlatformUserId UserID, FInputDeviceId DeviceId, FControllerState& State) const;
+	/// Press and release the gestures recognized by the last evaluation
+	void DispatchGestures(FPlatformUserId UserID, FInputDeviceId DeviceId, double Time, const FControllerState& State) const;
+	/// Dispatch the summed MouseInput deltas of the frame, one event per axis
+	void DispatchMouseDeltas(FPlatformUserId UserID, FInputDeviceId DeviceId, FControllerState& State);
+	/// Dispatch the motion integrated since the previous frame as the engine motion event and the gyro axes
+	void ProcessMotion(FPlatformUserId UserID, FInputDeviceId DeviceId, FControllerState& State);
+	/// Count an event handed to the message handler and stamp it for latency measurements
+	void OnEventEmitted(const FName& Key, const FSteamInputSample& Sample, const FControllerState& State, bool bAnalog, int32 ActionIndex) const;
 
 	void UpdateControllerState(const InputHandle_t* ConnectedControllers, int32 Count);
 	void GetPlatformUserAndDevice(FInputHandle InputHandle, FPlatformUserId& OutUserID, FInputDeviceId& OutDeviceId);
-	bool ShouldProcessKeyRepeat(const FName& ActionName, FControllerState& State, double CurrentTime) const;
-	void UpdateKeyRepeatTiming(const FName& ActionName, FControllerState& State, double CurrentTime) const;
+	bool ShouldProcessKeyRepeat(int32 ActionIndex, const FControllerState& State, double CurrentTime) const;
+	void UpdateKeyRepeatTiming(int32 ActionIndex, FControllerState& State, double CurrentTime) const;
 };
@@ -0,0 +1,96 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/FSteamInputMotionSampler.h"
+
+#include "Globals.h"
+#include "Controller/SteamInputLateLatch.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/SteamIPCStats.h"
+#include "steam/isteaminput.h"
+
+namespace
+{
+	/** Full scale of the motion data, readings range from -MAX_int16 to MAX_int16 */
+	constexpr float AccelerationRange = 2.0f;
+	constexpr float RotationRateRange = 2000.0f;
+	/** Longest gap between two readings that still gets integrated, anything longer is a stall rather than motion */
+	constexpr double MaxIntegrationStep = 0.1;
+}
+
+bool FSteamInputMotionSampler::ConsumeMotion(const InputHandle_t Controller, FSteamInputMotion& OutMotion)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FSteamInputMotion* Motion = Motions.Find(Controller);
+	if (!Motion)
+	{
+		return false;
+	}
+
+	OutMotion = *Motion;
+	Motion->RotationDelta = FVector::ZeroVector;
+	Motion->NumReadings = 0;
+	return true;
+}
+
+void FSteamInputMotionSampler::SetLateLatch(const TSharedPtr<FSteamInputLateLatch, ESPMode::ThreadSafe>& InLateLatch)
+{
+	FScopeLock ScopeLock(&Lock);
+	LateLatch = InLateLatch;
+}
+
+void FSteamInputMotionSampler::RemoveController(const InputHandle_t Controller)
+{
+	FScopeLock ScopeLock(&Lock);
+	Motions.Remove(Controller);
+}
+
+bool FSteamInputMotionSampler::ReadMotion(const InputHandle_t Controller, FSteamInputMotion& OutMotion)
+{
+	ISteamInput* Input = SteamInput();
+	if (!Input)
+	{
+		return false;
+	}
+
+	const InputMotionData_t Data = STEAM_IPC_CALL(Input, Input, GetMotionData, Controller);
+
+	OutMotion.Orientation = FQuat(Data.rotQuatX, Data.rotQuatY, Data.rotQuatZ, Data.rotQuatW);
+	OutMotion.Acceleration = FVector(Data.posAccelX, Data.posAccelY, Data.posAccelZ) * (AccelerationRange / MAX_int16);
+	OutMotion.RotationRate = FVector(Data.rotVelX, Data.rotVelY, Data.rotVelZ) * (RotationRateRange / MAX_int16);
+	OutMotion.Timestamp = FPlatformTime::Seconds();
+	return true;
+}
+
+void FSteamInputMotionSampler::Sample(const InputHandle_t* Controllers, const int32 ControllerCount)
+{
+	for (int32 i = 0; i < ControllerCount; ++i)
+	{
+		FSteamInputMotion Reading;
+		if (!ReadMotion(Controllers[i], Reading))
+		{
+			continue;
+		}
+
+		FScopeLock ScopeLock(&Lock);
+
+		FSteamInputMotion* Motion = Motions.Find(Controllers[i]);
+		if (!Motion)
+		{
+			Motions.Add(Controllers[i], Reading);
+			continue;
+		}
+
+		//integrate with the time that actually passed, neither the sampler thread nor the frames keep an exact rate
+		const double DeltaTime = FMath::Min(Reading.Timestamp - Motion->Timestamp, MaxIntegrationStep);
+		const FVector Rotation = Reading.RotationRate * DeltaTime;
+		Reading.RotationDelta = Motion->RotationDelta + Rotation;
+		Reading.NumReadings = Motion->NumReadings + 1;
+		*Motion = Reading;
+
+		if (LateLatch.IsValid())
+		{
+			LateLatch->WriteGyro(Controllers[i], Rotation);
+		}
+	}
+}
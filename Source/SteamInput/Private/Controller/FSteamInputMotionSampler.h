@@ -0,0 +1,45 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SteamInputTypes.h"
+
+class FSteamInputLateLatch;
+
+/**
+ * Reads the motion sensors of every connected controller through ISteamInput::GetMotionData and integrates their angular velocity
+ * into a rotation delta that the FSteamInputController takes once per frame.
+ * Steam only refreshes the sensors when it runs a frame, so Sample is called right after one. In the FixedRate sampling mode that is the
+ * FSteamInputSampler thread after each of its frames, so motion updates at SampleRate. In the other modes it is the game thread once per
+ * frame, after the callback pump ran Steam's frame, so motion only updates once per rendered frame and the gyro does not late latch.
+ */
+class FSteamInputMotionSampler
+{
+public:
+	/// Read and integrate the motion of the connected controllers, call right after Steam ran a frame
+	/// @param Controllers Connected controllers
+	/// @param ControllerCount Amount of controllers in Controllers
+	void Sample(const InputHandle_t* Controllers, int32 ControllerCount);
+
+	/// Take the motion of a controller, the rotation delta starts over afterwards
+	/// @param Controller Controller to read
+	/// @param OutMotion Receives the newest reading and the rotation integrated since the previous call
+	/// @return false if the controller was never read
+	bool ConsumeMotion(InputHandle_t Controller, FSteamInputMotion& OutMotion);
+
+	/// Feed the gyro of the late latched controller into a late latch, null to stop writing
+	void SetLateLatch(const TSharedPtr<FSteamInputLateLatch, ESPMode::ThreadSafe>& InLateLatch);
+
+	/// Forget a disconnected controller
+	void RemoveController(InputHandle_t Controller);
+
+	/// Read the motion sensors of a controller from SteamInput(), without integrating anything
+	/// @return false if Steam Input is not available
+	static bool ReadMotion(InputHandle_t Controller, FSteamInputMotion& OutMotion);
+
+private:
+	FCriticalSection Lock;
+	TMap<InputHandle_t, FSteamInputMotion> Motions;
+	TSharedPtr<FSteamInputLateLatch, ESPMode::ThreadSafe> LateLatch;
+};
@@ -0,0 +1,322 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/FSteamInputSampler.h"
+
+#include "Globals.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Controller/FSteamInputMotionSampler.h"
+#include "Controller/SteamInputLateLatch.h"
+#include "Controller/SteamInputSampleRing.h"
+#include "Controller/SteamInputSource.h"
+#include "Algo/Compare.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Profiling/SteamInputStats.h"
+#include "Profiling/SteamIPCStats.h"
+#include "steam/isteaminput.h"
+
+FSteamInputSampler::FSteamInputSampler(const TSharedRef<ISteamInputSource, ESPMode::ThreadSafe>& InSource, const double InSampleRate, const int32 InRingCapacity)
+	: Source(InSource)
+	, SamplePeriod(1.0 / FMath::Max(InSampleRate, 1.0))
+	, RingCapacity(FMath::Max(InRingCapacity, 2))
+{
+	Thread = FRunnableThread::Create(this, TEXT("SteamInputSampler"), 0, TPri_AboveNormal);
+
+	UE_LOG(SteamInputLog, Log, TEXT("Steam Input sampler started at %.1f Hz"), GetSampleRate());
+}
+
+FSteamInputSampler::~FSteamInputSampler()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+void FSteamInputSampler::SetActionTable(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& InActionTable)
+{
+	FScopeLock ScopeLock(&TableLock);
+	ActionTable = InActionTable;
+}
+
+void FSteamInputSampler::SetLateLatch(const TSharedPtr<FSteamInputLateLatch, ESPMode::ThreadSafe>& InLateLatch, const int32 InStickIndex)
+{
+	FScopeLock ScopeLock(&TableLock);
+	LateLatch = InLateLatch;
+	LateLatchStickIndex = InStickIndex;
+}
+
+void FSteamInputSampler::SetMotionSampler(const TSharedPtr<FSteamInputMotionSampler, ESPMode::ThreadSafe>& InMotionSampler)
+{
+	FScopeLock ScopeLock(&TableLock);
+	MotionSampler = InMotionSampler;
+}
+
+void FSteamInputSampler::SetActionSets(const InputHandle_t Controller, const InputActionSetHandle_t ActionSet, const TConstArrayView<InputActionSetHandle_t> Layers)
+{
+	FScopeLock ScopeLock(&ActionSetLock);
+
+	FActionSetRequest& Request = ActionSetRequests.FindOrAdd(Controller);
+	if (Request.bDirty || Request.ActionSet != ActionSet || !Algo::Compare(Request.Layers, Layers))
+	{
+		Request.ActionSet = ActionSet;
+		Request.Layers.Reset();
+		Request.Layers.Append(Layers.GetData(), Layers.Num());
+		Request.bDirty = true;
+	}
+}
+
+int32 FSteamInputSampler::ConsumeSamples(const InputHandle_t Controller, uint64& InOutLastSampleIndex, TArray<FSteamInputSample>& OutSamples) const
+{
+	const TSharedPtr<const FSteamInputSampleRing, ESPMode::ThreadSafe> Ring = FindRing(Controller);
+	if (!Ring.IsValid())
+	{
+		return 0;
+	}
+
+	//first read for this controller, don't replay whatever history the ring already holds
+	if (InOutLastSampleIndex == 0)
+	{
+		InOutLastSampleIndex = FMath::Max<uint64>(Ring->GetLatestIndex(), 1) - 1;
+	}
+
+	return Ring->ReadSince(InOutLastSampleIndex, OutSamples);
+}
+
+bool FSteamInputSampler::ReadSample(const InputHandle_t Controller, const uint64 SampleIndex, FSteamInputSample& OutSample) const
+{
+	const TSharedPtr<const FSteamInputSampleRing, ESPMode::ThreadSafe> Ring = FindRing(Controller);
+	return Ring.IsValid() && Ring->Read(SampleIndex, OutSample);
+}
+
+uint64 FSteamInputSampler::GetLatestSampleIndex(const InputHandle_t Controller) const
+{
+	const TSharedPtr<const FSteamInputSampleRing, ESPMode::ThreadSafe> Ring = FindRing(Controller);
+	return Ring.IsValid() ? Ring->GetLatestIndex() : 0;
+}
+
+void FSteamInputSampler::PollSample(const FSteamInputActionTable& Table, const FSteamInputPollList* PollList, const InputHandle_t Controller,
+	FSteamInputSample& OutSample)
+{
+	ISteamInput* Input = SteamInput();
+	if (!Input)
+	{
+		return;
+	}
+
+	STEAM_INPUT_SCOPE_CYCLE_COUNTER(Poll);
+	uint32 ActionsPolled = 0;
+
+	const auto PollDigital = [&](const int32 Index)
+	{
+		const FSteamInputActionTable::FDigitalAction& Action = Table.DigitalActions[Index];
+		if (Action.Handle != 0)
+		{
+			OutSample.Digital.Set(Index, STEAM_IPC_CALL(Input, Input, GetDigitalActionData, Controller, Action.Handle).bState);
+			++ActionsPolled;
+		}
+	};
+
+	const auto PollAnalog = [&](const int32 Index)
+	{
+		const FSteamInputActionTable::FAnalogAction& Action = Table.AnalogActions[Index];
+		if (Action.Handle != 0)
+		{
+			const InputAnalogActionData_t ActionData = STEAM_IPC_CALL(Input, Input, GetAnalogActionData, Controller, Action.Handle);
+			OutSample.Analog[Index] = FVector2f(ActionData.x, ActionData.y);
+			++ActionsPolled;
+		}
+	};
+
+	//actions outside the active set and layers only ever report inactive data, the poll list skips them
+	if (PollList && PollList->TableRevision == Table.Revision)
+	{
+		for (const int32 Index : PollList->Digital)
+		{
+			PollDigital(Index);
+		}
+		for (const int32 Index : PollList->Analog)
+		{
+			PollAnalog(Index);
+		}
+	}
+	else
+	{
+		for (int32 Index = 0; Index < Table.DigitalActions.Num(); ++Index)
+		{
+			PollDigital(Index);
+		}
+		for (int32 Index = 0; Index < Table.AnalogActions.Num(); ++Index)
+		{
+			PollAnalog(Index);
+		}
+	}
+
+	STEAM_INPUT_INC_COUNTER(ActionsPolled, ActionsPolled);
+}
+
+uint32 FSteamInputSampler::Run()
+{
+	double NextSampleTime = FPlatformTime::Seconds();
+
+	while (!bStopping)
+	{
+		TakeSample();
+
+		NextSampleTime += SamplePeriod;
+		const double Now = FPlatformTime::Seconds();
+
+		//if we fell more than a full period behind (thread starved, debugger break), resync instead of bursting samples
+		if (NextSampleTime < Now - SamplePeriod)
+		{
+			NextSampleTime = Now;
+		}
+		else if (NextSampleTime > Now)
+		{
+			FPlatformProcess::SleepNoStats(static_cast<float>(NextSampleTime - Now));
+		}
+	}
+
+	return 0;
+}
+
+void FSteamInputSampler::Stop()
+{
+	bStopping = true;
+}
+
+void FSteamInputSampler::TakeSample()
+{
+	TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> Table;
+	TSharedPtr<FSteamInputLateLatch, ESPMode::ThreadSafe> Latch;
+	TSharedPtr<FSteamInputMotionSampler, ESPMode::ThreadSafe> Motion;
+	int32 StickIndex;
+	{
+		FScopeLock ScopeLock(&TableLock);
+		Table = ActionTable;
+		Latch = LateLatch;
+		Motion = MotionSampler;
+		StickIndex = LateLatchStickIndex;
+	}
+
+	if (!Table.IsValid())
+	{
+		return;
+	}
+
+	ApplyActionSets();
+
+	//pull the latest state from the steam client, normally this only happens inside SteamAPI_RunCallbacks once per frame
+	Source->RunFrame();
+
+	InputHandle_t Controllers[STEAM_INPUT_MAX_COUNT];
+	const int32 ControllerCount = Source->GetConnectedControllers(Controllers);
+	RemoveDisconnected(Controllers, ControllerCount);
+
+	//the sensors were just refreshed by the frame above
+	if (Motion.IsValid())
+	{
+		Motion->Sample(Controllers, ControllerCount);
+	}
+
+	const uint64 SampleIndex = NextSampleIndex++;
+	const double Timestamp = FPlatformTime::Seconds();
+
+	for (int32 i = 0; i < ControllerCount; ++i)
+	{
+		ScratchSample.Init(*Table);
+		ScratchSample.SampleIndex = SampleIndex;
+		ScratchSample.Timestamp = Timestamp;
+
+		Source->PollSample(*Table, Controllers[i], ScratchSample);
+
+		if (Latch.IsValid() && ScratchSample.Analog.IsValidIndex(StickIndex))
+		{
+			Latch->WriteStick(Controllers[i], ScratchSample.Analog[StickIndex], Timestamp);
+		}
+
+		FindOrAddRing(Controllers[i]).Write(ScratchSample);
+	}
+}
+
+void FSteamInputSampler::ApplyActionSets()
+{
+	{
+		FScopeLock ScopeLock(&ActionSetLock);
+		for (TPair<InputHandle_t, FActionSetRequest>& Request : ActionSetRequests)
+		{
+			if (Request.Value.bDirty)
+			{
+				PendingActionSets.Add(Request);
+				Request.Value.bDirty = false;
+			}
+		}
+	}
+
+	ISteamInput* Input = SteamInput();
+	if (!Input)
+	{
+		PendingActionSets.Reset();
+		return;
+	}
+
+	for (const TPair<InputHandle_t, FActionSetRequest>& Request : PendingActionSets)
+	{
+		STEAM_IPC_CALL(Input, Input, ActivateActionSet, Request.Key, Request.Value.ActionSet);
+		STEAM_IPC_CALL(Input, Input, DeactivateAllActionSetLayers, Request.Key);
+		for (const InputActionSetHandle_t Layer : Request.Value.Layers)
+		{
+			STEAM_IPC_CALL(Input, Input, ActivateActionSetLayer, Request.Key, Layer);
+		}
+	}
+	PendingActionSets.Reset();
+}
+
+void FSteamInputSampler::RemoveDisconnected(const InputHandle_t* Controllers, const int32 ControllerCount)
+{
+	const TArrayView<const InputHandle_t> Connected(Controllers, ControllerCount);
+	{
+		FWriteScopeLock WriteLock(RingsLock);
+		for (auto It = Rings.CreateIterator(); It; ++It)
+		{
+			if (!Connected.Contains(It.Key()))
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	//a controller that comes back gets its action sets sent again
+	FScopeLock ScopeLock(&ActionSetLock);
+	for (auto It = ActionSetRequests.CreateIterator(); It; ++It)
+	{
+		if (!Connected.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+FSteamInputSampleRing& FSteamInputSampler::FindOrAddRing(const InputHandle_t Controller)
+{
+	{
+		FReadScopeLock ReadLock(RingsLock);
+		if (const TSharedPtr<FSteamInputSampleRing, ESPMode::ThreadSafe>* Ring = Rings.Find(Controller))
+		{
+			return **Ring;
+		}
+	}
+
+	//only the sampler thread adds and removes rings, the reference stays valid for the rest of the sample
+	FWriteScopeLock WriteLock(RingsLock);
+	return *Rings.Add(Controller, MakeShared<FSteamInputSampleRing, ESPMode::ThreadSafe>(RingCapacity));
+}
+
+TSharedPtr<const FSteamInputSampleRing, ESPMode::ThreadSafe> FSteamInputSampler::FindRing(const InputHandle_t Controller) const
+{
+	FReadScopeLock ReadLock(RingsLock);
+	return Rings.FindRef(Controller);
+}
@@ -0,0 +1,120 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "SteamInputTypes.h"
+#include "Controller/SteamInputSample.h"
+
+#include <atomic>
+
+struct FSteamInputActionTable;
+struct FSteamInputPollList;
+class FSteamInputLateLatch;
+class FSteamInputMotionSampler;
+class FSteamInputSampleRing;
+class ISteamInputSource;
+class FRunnableThread;
+
+/**
+ * Polls Steam Input on a background thread at a fixed rate, decoupled from the render frame rate.
+ * Every connected controller gets its own ring of samples that the FSteamInputController drains each frame,
+ * and that simulation code can read directly through USteamInputFunctionLibrary::GetInputSample.
+ * The sampler thread runs ISteamInput::RunFrame before every sample, so the polled state is at most a sample period old. The SteamCore
+ * callback pump keeps running Steam frames as well, both hold FSteamCoreModule::GetRunFrameLock while they do so frames never overlap.
+ * While it runs the sampler thread owns the action polling, action set changes are handed to it through SetActionSets so Steam never
+ * sees them from two threads. Rings of controllers that disconnected are dropped.
+ * Motion is read right after each of the sampler's frames as well, so the sensors are integrated at the sample rate.
+ */
+class FSteamInputSampler : public FRunnable
+{
+public:
+	/// @param InSource Source the controllers get polled from
+	/// @param InSampleRate Rate in Hz at which the controllers get polled
+	/// @param InRingCapacity Amount of samples kept per controller
+	FSteamInputSampler(const TSharedRef<ISteamInputSource, ESPMode::ThreadSafe>& InSource, double InSampleRate, int32 InRingCapacity);
+	virtual ~FSteamInputSampler() override;
+
+	/** Swap the action table polled by the sampler, samples taken with an older table are tagged with its revision */
+	void SetActionTable(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& InActionTable);
+	/// Feed the stick of the late latched controller into a late latch
+	/// @param InLateLatch Latch to write, null to stop writing
+	/// @param InStickIndex Analog index of the look action in the action table
+	void SetLateLatch(const TSharedPtr<FSteamInputLateLatch, ESPMode::ThreadSafe>& InLateLatch, int32 InStickIndex);
+	/// Read and integrate the motion sensors after every frame the sampler runs, null to leave motion alone
+	void SetMotionSampler(const TSharedPtr<FSteamInputMotionSampler, ESPMode::ThreadSafe>& InMotionSampler);
+	/// Request an action set and layers for a controller, activated on the sampler thread before the next sample when they changed
+	void SetActionSets(InputHandle_t Controller, InputActionSetHandle_t ActionSet, TConstArrayView<InputActionSetHandle_t> Layers);
+
+	/// Append all samples of a controller newer than InOutLastSampleIndex to OutSamples
+	/// @param Controller Controller to read the samples from
+	/// @param InOutLastSampleIndex Last sample the caller consumed, 0 to only receive the newest sample
+	/// @param OutSamples Array the samples get appended to
+	/// @return Amount of samples appended
+	int32 ConsumeSamples(InputHandle_t Controller, uint64& InOutLastSampleIndex, TArray<FSteamInputSample>& OutSamples) const;
+
+	/// Read any of the last RingCapacity samples of a controller
+	bool ReadSample(InputHandle_t Controller, uint64 SampleIndex, FSteamInputSample& OutSample) const;
+	/// Index of the newest sample taken for the controller, 0 if the controller was never sampled
+	uint64 GetLatestSampleIndex(InputHandle_t Controller) const;
+
+	double GetSampleRate() const {return 1.0 / SamplePeriod;}
+	int32 GetRingCapacity() const {return RingCapacity;}
+	const TSharedRef<ISteamInputSource, ESPMode::ThreadSafe>& GetSource() const {return Source;}
+
+	/// Poll the state of the actions in the table for a single controller from SteamInput()
+	/// @param Table Actions to poll
+	/// @param PollList Subset of the actions that can fire for the active action set and layers, null to poll every action
+	/// @param Controller Controller to poll
+	/// @param OutSample Sample to write the state into, must have been initialized with the same table. Actions left out keep their initial state
+	static void PollSample(const FSteamInputActionTable& Table, const FSteamInputPollList* PollList, InputHandle_t Controller, FSteamInputSample& OutSample);
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	void TakeSample();
+	/// Send the action set requests that changed since the last sample
+	void ApplyActionSets();
+	/// Drop the rings and action set requests of controllers that are no longer connected
+	void RemoveDisconnected(const InputHandle_t* Controllers, int32 ControllerCount);
+	FSteamInputSampleRing& FindOrAddRing(InputHandle_t Controller);
+	TSharedPtr<const FSteamInputSampleRing, ESPMode::ThreadSafe> FindRing(InputHandle_t Controller) const;
+
+	TSharedRef<ISteamInputSource, ESPMode::ThreadSafe> Source;
+	double SamplePeriod;
+	int32 RingCapacity;
+
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{false};
+
+	mutable FCriticalSection TableLock;
+	TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> ActionTable;
+	TSharedPtr<FSteamInputLateLatch, ESPMode::ThreadSafe> LateLatch;
+	int32 LateLatchStickIndex = INDEX_NONE;
+	TSharedPtr<FSteamInputMotionSampler, ESPMode::ThreadSafe> MotionSampler;
+
+	/** Rings are shared so a reader keeps a ring alive while the sampler drops it */
+	mutable FRWLock RingsLock;
+	TMap<InputHandle_t, TSharedPtr<FSteamInputSampleRing, ESPMode::ThreadSafe>> Rings;
+
+	struct FActionSetRequest
+	{
+		InputActionSetHandle_t ActionSet = 0;
+		TArray<InputActionSetHandle_t, TInlineAllocator<4>> Layers;
+		/** Set when the request changed and still has to be sent */
+		bool bDirty = true;
+	};
+
+	FCriticalSection ActionSetLock;
+	TMap<InputHandle_t, FActionSetRequest> ActionSetRequests;
+	/** Requests copied out of ActionSetRequests to be sent without holding the lock, only touched by the sampler thread */
+	TArray<TPair<InputHandle_t, FActionSetRequest>> PendingActionSets;
+
+	/** Only touched by the sampler thread */
+	uint64 NextSampleIndex = 1;
+	FSteamInputSample ScratchSample;
+};
@@ -0,0 +1,180 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputActionTable.h"
+
+#include "Globals.h"
+#include "Controller/SteamInputSample.h"
+#include "Helper/SteamInputFunctionLibrary.h"
+
+TSharedRef<const FSteamInputActionTable, ESPMode::ThreadSafe> FSteamInputActionTable::Build(const USteamInputSettings& Settings)
+{
+	const TSharedRef<FSteamInputActionTable, ESPMode::ThreadSafe> Table = MakeShared<FSteamInputActionTable, ESPMode::ThreadSafe>();
+	Table->Revision = Settings.GetHandleRevision();
+
+	for (const FSteamInputAction& Key : Settings.Keys)
+	{
+		//past the limits the frames could no longer be delta encoded, the remaining actions are dropped
+		const bool bDigital = Key.KeyType == EKeyType::Button;
+		if (bDigital ? Table->DigitalActions.Num() >= MaxDigitalActions : Table->AnalogActions.Num() >= MaxAnalogActions)
+		{
+			UE_LOG(SteamInputLog, Error, TEXT("Too many %s actions, %s is ignored"), bDigital ? TEXT("digital") : TEXT("analog"), *Key.ActionName.ToString());
+			continue;
+		}
+
+		switch (Key.KeyType)
+		{
+		case EKeyType::Button:
+			{
+				FDigitalAction& Action = Table->DigitalActions.AddDefaulted_GetRef();
+				Action.ActionName = Key.ActionName;
+				Action.Handle = Key.bHandleValid ? Key.CachedHandle : 0;
+			}
+			break;
+		default:
+			{
+				FAnalogAction& Action = Table->AnalogActions.AddDefaulted_GetRef();
+				Action.ActionName = Key.ActionName;
+				Action.Handle = Key.bHandleValid ? Key.CachedHandle : 0;
+				Action.KeyType = Key.KeyType;
+
+				if (Key.KeyType == EKeyType::Joystick || Key.KeyType == EKeyType::MouseInput)
+				{
+					Action.XAxisName = USteamInputSettings::GetXAxisName(Key.ActionName);
+					Action.YAxisName = USteamInputSettings::GetYAxisName(Key.ActionName);
+				}
+			}
+			break;
+		}
+	}
+
+	//actions of sets Steam does not know (yet) stay unscoped, the table is rebuilt once the handles resolve
+	Table->UnscopedDigital.Init(Table->DigitalActions.Num());
+	Table->UnscopedAnalog.Init(Table->AnalogActions.Num());
+	FSteamInputActionBits ScopedDigital;
+	FSteamInputActionBits ScopedAnalog;
+	ScopedDigital.Init(Table->DigitalActions.Num());
+	ScopedAnalog.Init(Table->AnalogActions.Num());
+
+	for (const FSteamInputActionSetActions& SetActions : Settings.ActionSets)
+	{
+		const InputActionSetHandle_t Handle = SetActions.ActionSetName.IsNone() ? 0 : USteamInputFunctionLibrary::GetActionSetHandle(SetActions.ActionSetName);
+		if (Handle == 0)
+		{
+			continue;
+		}
+
+		FActionSet& ActionSet = Table->ActionSets.AddDefaulted_GetRef();
+		ActionSet.ActionSetName = SetActions.ActionSetName;
+		ActionSet.Handle = Handle;
+		ActionSet.Digital.Init(Table->DigitalActions.Num());
+		ActionSet.Analog.Init(Table->AnalogActions.Num());
+
+		for (const FName& ActionName : SetActions.Actions)
+		{
+			if (const int32 DigitalIndex = Table->FindDigitalIndex(ActionName); DigitalIndex != INDEX_NONE)
+			{
+				ActionSet.Digital.Set(DigitalIndex, true);
+				ScopedDigital.Set(DigitalIndex, true);
+			}
+			else if (const int32 AnalogIndex = Table->FindAnalogIndex(ActionName); AnalogIndex != INDEX_NONE)
+			{
+				ActionSet.Analog.Set(AnalogIndex, true);
+				ScopedAnalog.Set(AnalogIndex, true);
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < Table->DigitalActions.Num(); ++Index)
+	{
+		Table->UnscopedDigital.Set(Index, !ScopedDigital.Get(Index));
+	}
+	for (int32 Index = 0; Index < Table->AnalogActions.Num(); ++Index)
+	{
+		Table->UnscopedAnalog.Set(Index, !ScopedAnalog.Get(Index));
+	}
+
+	return Table;
+}
+
+int32 FSteamInputActionTable::FindDigitalIndex(const FName ActionName) const
+{
+	return DigitalActions.IndexOfByPredicate([ActionName](const FDigitalAction& Action)
+	{
+		return Action.ActionName == ActionName;
+	});
+}
+
+int32 FSteamInputActionTable::FindAnalogIndex(const FName ActionName) const
+{
+	return AnalogActions.IndexOfByPredicate([ActionName](const FAnalogAction& Action)
+	{
+		return Action.ActionName == ActionName;
+	});
+}
+
+FSteamInputActionBits FSteamInputActionTable::MakeDigitalMask(const TConstArrayView<FName> ActionNames) const
+{
+	FSteamInputActionBits Mask;
+	Mask.Init(DigitalActions.Num());
+	for (const FName& ActionName : ActionNames)
+	{
+		const int32 ActionIndex = FindDigitalIndex(ActionName);
+		if (ActionIndex != INDEX_NONE)
+		{
+			Mask.Set(ActionIndex, true);
+		}
+	}
+	return Mask;
+}
+
+void FSteamInputActionTable::BuildPollList(const InputActionSetHandle_t ActionSet, const TConstArrayView<InputActionSetHandle_t> Layers,
+	FSteamInputPollList& OutPollList) const
+{
+	FSteamInputActionBits Digital = UnscopedDigital;
+	FSteamInputActionBits Analog = UnscopedAnalog;
+	for (const FActionSet& Set : ActionSets)
+	{
+		if (Set.Handle == ActionSet || Layers.Contains(Set.Handle))
+		{
+			Digital |= Set.Digital;
+			Analog |= Set.Analog;
+		}
+	}
+
+	OutPollList.TableRevision = Revision;
+	OutPollList.Digital.Reset();
+	OutPollList.Analog.Reset();
+	Digital.ForEachSetBit([this, &OutPollList](const int32 Index)
+	{
+		if (DigitalActions[Index].Handle != 0)
+		{
+			OutPollList.Digital.Add(Index);
+		}
+	});
+	Analog.ForEachSetBit([this, &OutPollList](const int32 Index)
+	{
+		if (AnalogActions[Index].Handle != 0)
+		{
+			OutPollList.Analog.Add(Index);
+		}
+	});
+}
+
+void FSteamInputSample::Init(const FSteamInputActionTable& Table)
+{
+	SampleIndex = 0;
+	Timestamp = 0.0;
+	TableRevision = Table.Revision;
+	Digital.Init(Table.DigitalActions.Num());
+	Analog.Reset();
+	Analog.SetNumZeroed(Table.AnalogActions.Num());
+}
+
+void FSteamInputActionEdges::Init(const FSteamInputActionTable& Table)
+{
+	FrameCounter = 0;
+	TableRevision = Table.Revision;
+	Down.Init(Table.DigitalActions.Num());
+	Pressed.Init(Table.DigitalActions.Num());
+	Released.Init(Table.DigitalActions.Num());
+}
@@ -0,0 +1,170 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputAnalogFilter.h"
+
+#include "Globals.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Controller/SteamInputSample.h"
+#include "Profiling/SteamInputStats.h"
+#include "Settings/SteamInputSettings.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	/** Smoothing factor of a low pass filter with the given cutoff frequencies, for a time step of DeltaTime */
+	FORCEINLINE VectorRegister4Float SmoothingFactor(const VectorRegister4Float& Cutoff, const VectorRegister4Float& TwoPiDeltaTime)
+	{
+		const VectorRegister4Float Tau = VectorMultiply(Cutoff, TwoPiDeltaTime);
+		return VectorDivide(Tau, VectorAdd(Tau, GlobalVectorConstants::FloatOne));
+	}
+}
+
+void FSteamInputAnalogFilter::Init(const FSteamInputActionTable& Table, const USteamInputSettings& Settings)
+{
+	NumAxes = Table.AnalogActions.Num() * 2;
+	NumPaddedAxes = Align(NumAxes, 4);
+	bEnabled = false;
+	bSmoothing = false;
+
+	for (FAxisArray* Parameter : {&DeadZone, &DeadZoneScale, &ResponseExponent, &ShapeWeight, &MinCutoff, &Beta, &DerivativeCutoff, &SmoothWeight, &HoldWeight, &Scratch})
+	{
+		Parameter->Reset();
+		Parameter->SetNumZeroed(NumPaddedAxes);
+	}
+
+	//defaults pass every axis through, including the padding
+	for (int32 Axis = 0; Axis < NumPaddedAxes; ++Axis)
+	{
+		DeadZoneScale[Axis] = 1.0f;
+		ResponseExponent[Axis] = 1.0f;
+		MinCutoff[Axis] = 1.0f;
+		DerivativeCutoff[Axis] = 1.0f;
+	}
+
+	for (int32 Index = 0; Index < Table.AnalogActions.Num(); ++Index)
+	{
+		const float Hold = Table.AnalogActions[Index].KeyType != EKeyType::MouseInput ? 1.0f : 0.0f;
+		HoldWeight[Index * 2] = Hold;
+		HoldWeight[Index * 2 + 1] = Hold;
+	}
+
+	for (const FSteamInputAnalogFilterSettings& Filter : Settings.AnalogFilters)
+	{
+		const int32 ActionIndex = Table.FindAnalogIndex(Filter.ActionName);
+		if (ActionIndex == INDEX_NONE)
+		{
+			UE_LOG(SteamInputLog, Warning, TEXT("Analog filter for %s does not match any analog action"), *Filter.ActionName.ToString());
+			continue;
+		}
+
+		const bool bShape = Table.AnalogActions[ActionIndex].KeyType != EKeyType::MouseInput;
+		const float Inner = FMath::Clamp(Filter.DeadZone, 0.0f, 1.0f);
+		const float Outer = FMath::Clamp(Filter.OuterDeadZone, Inner + UE_KINDA_SMALL_NUMBER, 1.0f);
+
+		for (int32 Axis = ActionIndex * 2; Axis < ActionIndex * 2 + 2; ++Axis)
+		{
+			DeadZone[Axis] = Inner;
+			DeadZoneScale[Axis] = 1.0f / (Outer - Inner);
+			ResponseExponent[Axis] = FMath::Max(Filter.ResponseExponent, 0.1f);
+			ShapeWeight[Axis] = bShape ? 1.0f : 0.0f;
+			MinCutoff[Axis] = FMath::Max(Filter.MinCutoff, 0.01f);
+			Beta[Axis] = FMath::Max(Filter.Beta, 0.0f);
+			DerivativeCutoff[Axis] = FMath::Max(Filter.DerivativeCutoff, 0.01f);
+			SmoothWeight[Axis] = Filter.bSmooth ? 1.0f : 0.0f;
+		}
+
+		bEnabled = true;
+		bSmoothing |= Filter.bSmooth;
+	}
+}
+
+void FSteamInputAnalogFilter::InitState(FState& State) const
+{
+	State.Value.Reset();
+	State.Value.SetNumZeroed(NumPaddedAxes);
+	State.Derivative.Reset();
+	State.Derivative.SetNumZeroed(NumPaddedAxes);
+	State.Input.Reset();
+	State.Input.SetNumZeroed(NumPaddedAxes);
+	State.LastTimestamp = 0.0;
+	State.bSettling = false;
+}
+
+void FSteamInputAnalogFilter::Apply(FSteamInputSample& Sample, FState& State)
+{
+	if (!bEnabled || Sample.Analog.Num() * 2 != NumAxes || State.Value.Num() != NumPaddedAxes)
+	{
+		return;
+	}
+
+	STEAM_INPUT_SCOPE_CYCLE_COUNTER(Filter);
+
+	FMemory::Memcpy(Scratch.GetData(), Sample.Analog.GetData(), NumAxes * sizeof(float));
+	FMemory::Memcpy(State.Input.GetData(), Scratch.GetData(), NumPaddedAxes * sizeof(float));
+
+	//the first sample only seeds the history, there is no time step to smooth over yet
+	const bool bSeed = State.LastTimestamp <= 0.0;
+	const float DeltaTime = bSeed ? 0.0f : static_cast<float>(FMath::Clamp(Sample.Timestamp - State.LastTimestamp, 0.001, 1.0));
+	State.LastTimestamp = Sample.Timestamp;
+
+	const VectorRegister4Float TwoPiDeltaTime = VectorSetFloat1(UE_TWO_PI * DeltaTime);
+	const VectorRegister4Float Rate = VectorSetFloat1(bSeed ? 0.0f : 1.0f / DeltaTime);
+	const VectorRegister4Float Tolerance = VectorSetFloat1(SettleTolerance);
+	uint32 bSettling = 0;
+
+	for (int32 Axis = 0; Axis < NumPaddedAxes; Axis += 4)
+	{
+		VectorRegister4Float Value = VectorLoadAligned(&Scratch[Axis]);
+
+		//radial dead zones, X and Y of an action are neighbours so swapping pairs yields the magnitude in both lanes
+		const VectorRegister4Float Squared = VectorMultiply(Value, Value);
+		const VectorRegister4Float Magnitude = VectorSqrt(VectorAdd(Squared, VectorSwizzle(Squared, 1, 0, 3, 2)));
+		const VectorRegister4Float Scaled = VectorMin(VectorMax(VectorMultiply(VectorSubtract(Magnitude, VectorLoadAligned(&DeadZone[Axis])),
+			VectorLoadAligned(&DeadZoneScale[Axis])), GlobalVectorConstants::FloatZero), GlobalVectorConstants::FloatOne);
+		const VectorRegister4Float Curved = VectorPow(Scaled, VectorLoadAligned(&ResponseExponent[Axis]));
+		const VectorRegister4Float Shaped = VectorMultiply(Value, VectorDivide(Curved, VectorMax(Magnitude, GlobalVectorConstants::SmallNumber)));
+		Value = VectorMultiplyAdd(VectorSubtract(Shaped, Value), VectorLoadAligned(&ShapeWeight[Axis]), Value);
+
+		//one euro filter, the cutoff follows the smoothed speed of the axis
+		const VectorRegister4Float Previous = bSeed ? Value : VectorLoadAligned(&State.Value[Axis]);
+		const VectorRegister4Float PreviousDerivative = VectorLoadAligned(&State.Derivative[Axis]);
+
+		const VectorRegister4Float Derivative = VectorMultiply(VectorSubtract(Value, Previous), Rate);
+		const VectorRegister4Float SmoothedDerivative = VectorMultiplyAdd(VectorSubtract(Derivative, PreviousDerivative),
+			SmoothingFactor(VectorLoadAligned(&DerivativeCutoff[Axis]), TwoPiDeltaTime), PreviousDerivative);
+
+		const VectorRegister4Float Cutoff = VectorMultiplyAdd(VectorLoadAligned(&Beta[Axis]), VectorAbs(SmoothedDerivative), VectorLoadAligned(&MinCutoff[Axis]));
+		const VectorRegister4Float Smoothed = VectorMultiplyAdd(VectorSubtract(Value, Previous), SmoothingFactor(Cutoff, TwoPiDeltaTime), Previous);
+		const VectorRegister4Float Lag = VectorMultiply(VectorSubtract(bSeed ? Value : Smoothed, Value), VectorLoadAligned(&SmoothWeight[Axis]));
+		bSettling |= VectorAnyGreaterThan(VectorAbs(Lag), Tolerance);
+		Value = VectorAdd(Value, Lag);
+
+		VectorStoreAligned(Value, &State.Value[Axis]);
+		VectorStoreAligned(SmoothedDerivative, &State.Derivative[Axis]);
+		VectorStoreAligned(Value, &Scratch[Axis]);
+	}
+
+	FMemory::Memcpy(Sample.Analog.GetData(), Scratch.GetData(), NumAxes * sizeof(float));
+	State.bSettling = bSettling != 0;
+}
+
+bool FSteamInputAnalogFilter::Settle(FSteamInputSample& Sample, FState& State, const double Timestamp)
+{
+	if (!bSmoothing || !State.bSettling || Sample.Analog.Num() * 2 != NumAxes || State.Input.Num() != NumPaddedAxes)
+	{
+		return false;
+	}
+
+	//replay the last input as a sample at the new time, deltas did not continue so they count as 0
+	for (int32 Axis = 0; Axis < NumPaddedAxes; Axis += 4)
+	{
+		VectorStoreAligned(VectorMultiply(VectorLoadAligned(&State.Input[Axis]), VectorLoadAligned(&HoldWeight[Axis])), &State.Input[Axis]);
+	}
+	FMemory::Memcpy(Sample.Analog.GetData(), State.Input.GetData(), NumAxes * sizeof(float));
+
+	const double SampleTimestamp = Sample.Timestamp;
+	Sample.Timestamp = Timestamp;
+	Apply(Sample, State);
+	Sample.Timestamp = SampleTimestamp;
+	return true;
+}
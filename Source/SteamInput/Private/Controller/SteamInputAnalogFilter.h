@@ -0,0 +1,83 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSteamInputActionTable;
+struct FSteamInputSample;
+class USteamInputSettings;
+
+/**
+ * Dead zones, response curve and one euro smoothing of USteamInputSettings::AnalogFilters, run over every axis of a sample at once.
+ * The axes of a sample are already packed as X/Y pairs, the parameters are expanded to the same layout so a whole sample is filtered
+ * four axes at a time with VectorRegister4Float. Axes without a filter pass through unchanged.
+ */
+class FSteamInputAnalogFilter
+{
+public:
+	/** Filter history of a single controller */
+	struct FState
+	{
+		/** Last filtered value and speed of every axis */
+		TArray<float, TAlignedHeapAllocator<16>> Value;
+		TArray<float, TAlignedHeapAllocator<16>> Derivative;
+		/** Unfiltered axes of the last sample, what the smoothing converges towards while no sample arrives */
+		TArray<float, TAlignedHeapAllocator<16>> Input;
+		/** Timestamp of the last filtered sample, 0 until the first sample initialized the history */
+		double LastTimestamp = 0.0;
+		/** Whether a smoothed axis has not caught up with its input yet */
+		bool bSettling = false;
+	};
+
+	/// Expand the filter settings of every analog action in the table into per axis parameters
+	void Init(const FSteamInputActionTable& Table, const USteamInputSettings& Settings);
+	/** Whether any action has a filter configured, nothing needs to run otherwise */
+	bool IsEnabled() const {return bEnabled;}
+
+	/// Size and clear the history of a controller
+	void InitState(FState& State) const;
+
+	/// Filter every axis of a sample in place
+	/// @param Sample Sample taken with the table the filter was initialized with
+	/// @param State History of the controller the sample belongs to
+	void Apply(FSteamInputSample& Sample, FState& State);
+
+	/// Step the smoothing towards the input of the last sample, for frames without a sample such as with action events.
+	/// MouseInput axes settle towards 0 as their input is a delta.
+	/// @param Sample Receives the filtered axes, the other members are left untouched
+	/// @param State History of the controller
+	/// @param Timestamp Time to step the filter to
+	/// @return false if nothing was settling and Sample is unchanged
+	bool Settle(FSteamInputSample& Sample, FState& State, double Timestamp);
+
+private:
+	using FAxisArray = TArray<float, TAlignedHeapAllocator<16>>;
+
+	/** Amount of axes, two per analog action, and that amount rounded up to full vectors */
+	int32 NumAxes = 0;
+	int32 NumPaddedAxes = 0;
+	bool bEnabled = false;
+
+	/** Per axis parameters, both axes of an action share the parameters of the action */
+	FAxisArray DeadZone;
+	/** 1 / (OuterDeadZone - DeadZone) */
+	FAxisArray DeadZoneScale;
+	FAxisArray ResponseExponent;
+	/** 1 where dead zones and the response curve apply, 0 to pass the axis through */
+	FAxisArray ShapeWeight;
+	FAxisArray MinCutoff;
+	FAxisArray Beta;
+	FAxisArray DerivativeCutoff;
+	/** 1 where the one euro filter applies, 0 to pass the axis through */
+	FAxisArray SmoothWeight;
+	/** 1 where the input holds its value between samples, 0 for MouseInput deltas */
+	FAxisArray HoldWeight;
+	bool bSmoothing = false;
+
+	/** Distance below which a smoothed axis counts as caught up with its input, about one int16 quantization step */
+	static constexpr float SettleTolerance = 1.0f / 32768.0f;
+
+	/** Aligned copy of the sample axes, padded to full vectors */
+	FAxisArray Scratch;
+};
@@ -0,0 +1,170 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputFrame.h"
+
+#include "Controller/SteamInputActionTable.h"
+#include "Serialization/Archive.h"
+
+void FSteamInputFrame::Init(const FSteamInputActionTable& Table)
+{
+	Tick = 0;
+	Digital.Init(Table.DigitalActions.Num());
+	Axes.Reset();
+	Axes.SetNumZeroed(Table.AnalogActions.Num() * 2);
+}
+
+void FSteamInputFrame::Quantize(const FSteamInputActionTable& Table, const FSteamInputSample& Sample)
+{
+	Tick = Sample.SampleIndex;
+	Digital = Sample.Digital;
+
+	for (int32 Index = 0; Index < Table.AnalogActions.Num(); ++Index)
+	{
+		const EKeyType KeyType = Table.AnalogActions[Index].KeyType;
+		Axes[Index * 2] = QuantizeAxis(Sample.Analog[Index].X, KeyType);
+		Axes[Index * 2 + 1] = QuantizeAxis(Sample.Analog[Index].Y, KeyType);
+	}
+}
+
+void FSteamInputFrame::Dequantize(const FSteamInputActionTable& Table, FSteamInputSample& OutSample) const
+{
+	OutSample.Init(Table);
+	OutSample.SampleIndex = Tick;
+	OutSample.Digital = Digital;
+
+	for (int32 Index = 0; Index < Table.AnalogActions.Num(); ++Index)
+	{
+		OutSample.Analog[Index] = GetAnalog(Table, Index);
+	}
+}
+
+FVector2f FSteamInputFrame::GetAnalog(const FSteamInputActionTable& Table, const int32 AnalogIndex) const
+{
+	const EKeyType KeyType = Table.AnalogActions[AnalogIndex].KeyType;
+	return FVector2f(DequantizeAxis(Axes[AnalogIndex * 2], KeyType), DequantizeAxis(Axes[AnalogIndex * 2 + 1], KeyType));
+}
+
+void FSteamInputFrame::SaveDelta(FArchive& Ar, const FSteamInputFrame& Baseline) const
+{
+	SaveDelta(Ar, Digital.Words, Axes, Baseline.Digital.Words, Baseline.Axes);
+}
+
+void FSteamInputFrame::SaveDelta(FArchive& Ar, const TConstArrayView<uint64> Words, const TConstArrayView<int16> Axes,
+	const TConstArrayView<uint64> BaselineWords, const TConstArrayView<int16> BaselineAxes)
+{
+	check(Ar.IsSaving());
+
+	// Digital: one bit per changed 64 bit word, followed by the xor of every changed word
+	const int32 NumWords = Words.Num();
+	if (NumWords > MaxDeltaWords || BaselineWords.Num() != NumWords || BaselineAxes.Num() != Axes.Num())
+	{
+		Ar.SetError();
+		return;
+	}
+
+	uint32 ChangedWords = 0;
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		if (Words[Word] != BaselineWords[Word])
+		{
+			ChangedWords |= 1u << Word;
+		}
+	}
+	Ar.SerializeIntPacked(ChangedWords);
+
+	for (uint32 Changed = ChangedWords; Changed; Changed &= Changed - 1)
+	{
+		const int32 Word = FMath::CountTrailingZeros(Changed);
+		uint64 Xor = Words[Word] ^ BaselineWords[Word];
+		Ar << Xor;
+	}
+
+	// Axes: a changed mask per group of 8 axes, followed by the zigzag encoded difference of every changed axis
+	for (int32 Group = 0; Group < Axes.Num(); Group += 8)
+	{
+		const int32 GroupSize = FMath::Min(8, Axes.Num() - Group);
+
+		uint8 ChangedAxes = 0;
+		for (int32 Axis = 0; Axis < GroupSize; ++Axis)
+		{
+			if (Axes[Group + Axis] != BaselineAxes[Group + Axis])
+			{
+				ChangedAxes |= 1 << Axis;
+			}
+		}
+		Ar << ChangedAxes;
+
+		for (int32 Axis = 0; Axis < GroupSize; ++Axis)
+		{
+			if (ChangedAxes & (1 << Axis))
+			{
+				const int32 Index = Group + Axis;
+				uint32 Delta = ZigZagEncode(static_cast<int32>(Axes[Index]) - BaselineAxes[Index]);
+				Ar.SerializeIntPacked(Delta);
+			}
+		}
+	}
+}
+
+void FSteamInputFrame::LoadDelta(FArchive& Ar, const FSteamInputFrame& Baseline)
+{
+	check(Ar.IsLoading());
+
+	Digital = Baseline.Digital;
+	Axes = Baseline.Axes;
+
+	const int32 NumWords = Digital.Words.Num();
+	if (NumWords > MaxDeltaWords)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	uint32 ChangedWords = 0;
+	Ar.SerializeIntPacked(ChangedWords);
+
+	//a changed word past the layout means the data was written with another table
+	if (NumWords < MaxDeltaWords && (ChangedWords >> NumWords) != 0)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	for (uint32 Changed = ChangedWords; Changed; Changed &= Changed - 1)
+	{
+		const int32 Word = FMath::CountTrailingZeros(Changed);
+		uint64 Xor = 0;
+		Ar << Xor;
+		Digital.Words[Word] ^= Xor;
+	}
+
+	for (int32 Group = 0; Group < Axes.Num() && !Ar.IsError(); Group += 8)
+	{
+		const int32 GroupSize = FMath::Min(8, Axes.Num() - Group);
+
+		uint8 ChangedAxes = 0;
+		Ar << ChangedAxes;
+
+		for (int32 Axis = 0; Axis < GroupSize; ++Axis)
+		{
+			if (ChangedAxes & (1 << Axis))
+			{
+				const int32 Index = Group + Axis;
+				uint32 Delta = 0;
+				Ar.SerializeIntPacked(Delta);
+				Axes[Index] = static_cast<int16>(Baseline.Axes[Index] + ZigZagDecode(Delta));
+			}
+		}
+	}
+}
+
+int16 FSteamInputFrame::QuantizeAxis(const float Value, const EKeyType KeyType)
+{
+	const float Scaled = KeyType == EKeyType::MouseInput ? Value * MouseInputScale : FMath::Clamp(Value, -1.0f, 1.0f) * MAX_int16;
+	return static_cast<int16>(FMath::Clamp(FMath::RoundToInt32(Scaled), -MAX_int16, static_cast<int32>(MAX_int16)));
+}
+
+float FSteamInputFrame::DequantizeAxis(const int16 Value, const EKeyType KeyType)
+{
+	return KeyType == EKeyType::MouseInput ? Value / MouseInputScale : static_cast<float>(Value) / MAX_int16;
+}
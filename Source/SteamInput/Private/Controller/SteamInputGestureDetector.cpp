@@ -0,0 +1,329 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputGestureDetector.h"
+
+#include "Globals.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Controller/SteamInputSample.h"
+
+namespace
+{
+	FORCEINLINE bool AnyMasked(const uint64* Bits, const uint64* Mask, const int32 NumWords)
+	{
+		for (int32 Word = 0; Word < NumWords; ++Word)
+		{
+			if (Bits[Word] & Mask[Word])
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FORCEINLINE bool AllMasked(const uint64* Bits, const uint64* Mask, const int32 NumWords)
+	{
+		for (int32 Word = 0; Word < NumWords; ++Word)
+		{
+			if ((Bits[Word] & Mask[Word]) != Mask[Word])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Whether any bit is set that is part of Mask but not of Excluded */
+	FORCEINLINE bool AnyMaskedExcept(const uint64* Bits, const uint64* Mask, const uint64* Excluded, const int32 NumWords)
+	{
+		for (int32 Word = 0; Word < NumWords; ++Word)
+		{
+			if (Bits[Word] & Mask[Word] & ~Excluded[Word])
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+void FSteamInputGestureDetector::Init(const FSteamInputActionTable& Table, const USteamInputSettings& Settings)
+{
+	NumDigital = Table.DigitalActions.Num();
+	NumWords = FMath::DivideAndRoundUp(NumDigital, 64);
+
+	Gestures.Reset();
+	Steps.Reset();
+	StepMasks.Reset();
+	GestureMasks.Reset();
+	StepActions.Reset();
+
+	for (const FSteamInputGesture& Gesture : Settings.Gestures)
+	{
+		bool bValid = !Gesture.GestureName.IsNone() && Gesture.Steps.Num() > 0;
+		for (const FSteamInputGestureStep& Step : Gesture.Steps)
+		{
+			bValid &= Step.Actions.Num() > 0;
+			for (const FName& ActionName : Step.Actions)
+			{
+				bValid &= Table.FindDigitalIndex(ActionName) != INDEX_NONE;
+			}
+		}
+
+		if (!bValid)
+		{
+			UE_LOG(SteamInputLog, Warning, TEXT("Gesture %s needs a name and steps that only use digital actions"), *Gesture.GestureName.ToString());
+			continue;
+		}
+
+		FGesture& Compiled = Gestures.AddDefaulted_GetRef();
+		Compiled.GestureName = Gesture.GestureName;
+		Compiled.FirstStep = Steps.Num();
+		Compiled.NumSteps = Gesture.Steps.Num();
+
+		const int32 GestureMask = GestureMasks.AddZeroed(NumWords);
+		for (const FSteamInputGestureStep& Step : Gesture.Steps)
+		{
+			FStep& CompiledStep = Steps.AddDefaulted_GetRef();
+			CompiledStep.Type = Step.Type;
+			CompiledStep.Duration = FMath::Max(Step.Duration, 0.0f);
+			CompiledStep.MaxDelay = FMath::Max(Step.MaxDelay, 0.0f);
+			CompiledStep.FirstAction = StepActions.Num();
+
+			const int32 StepMask = StepMasks.AddZeroed(NumWords);
+			for (const FName& ActionName : Step.Actions)
+			{
+				const int32 ActionIndex = Table.FindDigitalIndex(ActionName);
+				const uint64 Bit = 1ull << (ActionIndex & 63);
+				if (!(StepMasks[StepMask + (ActionIndex >> 6)] & Bit))
+				{
+					StepMasks[StepMask + (ActionIndex >> 6)] |= Bit;
+					GestureMasks[GestureMask + (ActionIndex >> 6)] |= Bit;
+					StepActions.Add(ActionIndex);
+				}
+			}
+			CompiledStep.NumActions = StepActions.Num() - CompiledStep.FirstAction;
+		}
+	}
+
+	//index the gestures by the actions they use, so a sample only visits the gestures its changes can affect
+	ActionGestureStart.Reset();
+	ActionGestureStart.SetNumZeroed(NumDigital + 1);
+	for (int32 GestureIndex = 0; GestureIndex < Gestures.Num(); ++GestureIndex)
+	{
+		for (int32 ActionIndex = 0; ActionIndex < NumDigital; ++ActionIndex)
+		{
+			ActionGestureStart[ActionIndex + 1] += (GestureMasks[GestureIndex * NumWords + (ActionIndex >> 6)] >> (ActionIndex & 63)) & 1;
+		}
+	}
+
+	for (int32 ActionIndex = 0; ActionIndex < NumDigital; ++ActionIndex)
+	{
+		ActionGestureStart[ActionIndex + 1] += ActionGestureStart[ActionIndex];
+	}
+
+	ActionGestures.Reset();
+	ActionGestures.SetNumUninitialized(ActionGestureStart[NumDigital]);
+	TArray<int32> Fill(ActionGestureStart.GetData(), NumDigital);
+	for (int32 GestureIndex = 0; GestureIndex < Gestures.Num(); ++GestureIndex)
+	{
+		for (int32 ActionIndex = 0; ActionIndex < NumDigital; ++ActionIndex)
+		{
+			if ((GestureMasks[GestureIndex * NumWords + (ActionIndex >> 6)] >> (ActionIndex & 63)) & 1)
+			{
+				ActionGestures[Fill[ActionIndex]++] = GestureIndex;
+			}
+		}
+	}
+}
+
+void FSteamInputGestureDetector::InitState(FState& State) const
+{
+	State.Cursor.Reset();
+	State.Cursor.SetNumZeroed(Gestures.Num());
+	State.StepTime.Reset();
+	State.StepTime.SetNumZeroed(Gestures.Num());
+	State.VisitStamp.Reset();
+	State.VisitStamp.SetNumZeroed(Gestures.Num());
+	State.Stamp = 0;
+	State.PressTime.Reset();
+	State.PressTime.SetNumZeroed(NumDigital);
+	State.Holding.Reset();
+	State.Recognized.Reset();
+	State.Pressed.Reset();
+	State.Pressed.SetNumZeroed(NumWords);
+	State.Released.Reset();
+	State.Released.SetNumZeroed(NumWords);
+	State.Visit.Reset();
+}
+
+void FSteamInputGestureDetector::Evaluate(const FSteamInputSample& Sample, const FSteamInputActionBits& Previous, FState& State) const
+{
+	State.Recognized.Reset();
+
+	if (Sample.Digital.Num() != NumDigital || Previous.Num() != NumDigital || State.Cursor.Num() != Gestures.Num())
+	{
+		return;
+	}
+
+	const uint64* Down = Sample.Digital.Words.GetData();
+	const double Time = Sample.Timestamp;
+
+	//gestures waiting on a hold are visited no matter what changed
+	++State.Stamp;
+	State.Visit.Reset();
+	for (const int32 GestureIndex : State.Holding)
+	{
+		State.VisitStamp[GestureIndex] = State.Stamp;
+		State.Visit.Add(GestureIndex);
+	}
+
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		State.Pressed[Word] = Down[Word] & ~Previous.Words[Word];
+		State.Released[Word] = ~Down[Word] & Previous.Words[Word];
+
+		for (uint64 Changed = State.Pressed[Word] | State.Released[Word]; Changed; Changed &= Changed - 1)
+		{
+			const int32 ActionIndex = Word * 64 + FMath::CountTrailingZeros64(Changed);
+			if (State.Pressed[Word] & (1ull << (ActionIndex & 63)))
+			{
+				State.PressTime[ActionIndex] = Time;
+			}
+
+			for (int32 Entry = ActionGestureStart[ActionIndex]; Entry < ActionGestureStart[ActionIndex + 1]; ++Entry)
+			{
+				const int32 GestureIndex = ActionGestures[Entry];
+				if (State.VisitStamp[GestureIndex] != State.Stamp)
+				{
+					State.VisitStamp[GestureIndex] = State.Stamp;
+					State.Visit.Add(GestureIndex);
+				}
+			}
+		}
+	}
+
+	State.Holding.Reset();
+	for (const int32 GestureIndex : State.Visit)
+	{
+		bool bHolding = false;
+		if (Advance(GestureIndex, Down, Time, State, bHolding))
+		{
+			State.Recognized.Add(GestureIndex);
+		}
+
+		if (bHolding)
+		{
+			State.Holding.Add(GestureIndex);
+		}
+	}
+}
+
+void FSteamInputGestureDetector::Tick(const FSteamInputActionBits& Down, const double Time, FState& State) const
+{
+	State.Recognized.Reset();
+
+	if (State.Holding.IsEmpty() || Down.Num() != NumDigital || State.Cursor.Num() != Gestures.Num())
+	{
+		return;
+	}
+
+	//nothing changed since the last sample, only the time moved on
+	FMemory::Memzero(State.Pressed.GetData(), NumWords * sizeof(uint64));
+	FMemory::Memzero(State.Released.GetData(), NumWords * sizeof(uint64));
+
+	Swap(State.Visit, State.Holding);
+	State.Holding.Reset();
+	for (const int32 GestureIndex : State.Visit)
+	{
+		bool bHolding = false;
+		if (Advance(GestureIndex, Down.Words.GetData(), Time, State, bHolding))
+		{
+			State.Recognized.Add(GestureIndex);
+		}
+
+		if (bHolding)
+		{
+			State.Holding.Add(GestureIndex);
+		}
+	}
+}
+
+bool FSteamInputGestureDetector::Advance(const int32 GestureIndex, const uint64* Down, const double Time, FState& State, bool& bOutHolding) const
+{
+	const FGesture& Gesture = Gestures[GestureIndex];
+	const uint64* Pressed = State.Pressed.GetData();
+	const uint64* Released = State.Released.GetData();
+	int32& Cursor = State.Cursor[GestureIndex];
+
+	//pressing an action of the gesture the current step does not expect breaks the sequence, the press may start it over
+	if (Cursor > 0 && AnyMaskedExcept(Pressed, &GestureMasks[GestureIndex * NumWords], &StepMasks[(Gesture.FirstStep + Cursor) * NumWords], NumWords))
+	{
+		Cursor = 0;
+	}
+
+	for (;;)
+	{
+		const int32 StepIndex = Gesture.FirstStep + Cursor;
+		const FStep& Step = Steps[StepIndex];
+		const uint64* Mask = &StepMasks[StepIndex * NumWords];
+
+		//the time the step was reached, checked against the delay allowed after the previous step
+		double ReachedTime = Time;
+		bool bMatched = false;
+		bOutHolding = false;
+
+		switch (Step.Type)
+		{
+		case ESteamInputGestureStepType::Press:
+			if (AnyMasked(Pressed, Mask, NumWords) && AllMasked(Down, Mask, NumWords))
+			{
+				double FirstPress = Time;
+				for (int32 Action = Step.FirstAction; Action < Step.FirstAction + Step.NumActions; ++Action)
+				{
+					FirstPress = FMath::Min(FirstPress, State.PressTime[StepActions[Action]]);
+				}
+				bMatched = Step.Duration <= 0.0f || Time - FirstPress <= Step.Duration;
+			}
+			break;
+		case ESteamInputGestureStepType::Release:
+			bMatched = AnyMasked(Released, Mask, NumWords) && !AnyMasked(Down, Mask, NumWords);
+			break;
+		case ESteamInputGestureStepType::Hold:
+			if (AllMasked(Down, Mask, NumWords))
+			{
+				//the hold counts from the last press of its actions, and never from before the previous step
+				ReachedTime = Cursor > 0 ? State.StepTime[GestureIndex] : 0.0;
+				for (int32 Action = Step.FirstAction; Action < Step.FirstAction + Step.NumActions; ++Action)
+				{
+					ReachedTime = FMath::Max(ReachedTime, State.PressTime[StepActions[Action]]);
+				}
+				bMatched = Time - ReachedTime >= Step.Duration;
+				bOutHolding = !bMatched;
+			}
+			break;
+		}
+
+		const bool bInTime = Cursor == 0 || ReachedTime - State.StepTime[GestureIndex] <= Step.MaxDelay;
+		if (bMatched && bInTime)
+		{
+			State.StepTime[GestureIndex] = Time;
+			if (++Cursor == Gesture.NumSteps)
+			{
+				Cursor = 0;
+				return true;
+			}
+
+			//a following hold may already be down, it is checked from the next sample on
+			bOutHolding = Steps[StepIndex + 1].Type == ESteamInputGestureStepType::Hold;
+			return false;
+		}
+
+		if (bInTime)
+		{
+			return false;
+		}
+
+		//timed out, the sample may still start the gesture over
+		Cursor = 0;
+	}
+}
@@ -0,0 +1,105 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Settings/SteamInputSettings.h"
+
+struct FSteamInputActionTable;
+struct FSteamInputActionBits;
+struct FSteamInputSample;
+
+/**
+ * Recognizes the USteamInputSettings::Gestures on the digital actions of every sample.
+ * Gestures are compiled into flat tables of per step bitmasks over the digital index space and each gesture moves a single cursor
+ * through its steps. A sample only visits the gestures using an action that changed in it, found through a per action index, plus
+ * the few waiting for a hold to complete, so hundreds of configured gestures cost next to nothing while their actions are idle.
+ */
+class FSteamInputGestureDetector
+{
+public:
+	/** Progress of every gesture on a single controller */
+	struct FState
+	{
+		/** Per gesture, index of the next step to match */
+		TArray<int32> Cursor;
+		/** Per gesture, timestamp of the last matched step */
+		TArray<double> StepTime;
+		/** Per gesture, stamp of the last sample that visited it */
+		TArray<uint32> VisitStamp;
+		uint32 Stamp = 0;
+		/** Per digital action, timestamp of the last press */
+		TArray<double> PressTime;
+		/** Gestures waiting for a hold to complete, visited on every sample and frame until it completes or breaks */
+		TArray<int32> Holding;
+		/** Gestures recognized by the last Evaluate or Tick */
+		TArray<int32> Recognized;
+
+		/** Scratch buffers, kept around so steady state evaluation doesn't allocate */
+		TArray<uint64, TInlineAllocator<2>> Pressed;
+		TArray<uint64, TInlineAllocator<2>> Released;
+		TArray<int32> Visit;
+	};
+
+	/// Compile the gestures of the settings against the digital actions of the table
+	void Init(const FSteamInputActionTable& Table, const USteamInputSettings& Settings);
+	/** Whether any gesture compiled, nothing needs to run otherwise */
+	bool IsEnabled() const {return Gestures.Num() > 0;}
+
+	/// Size and clear the progress of a controller
+	void InitState(FState& State) const;
+
+	/// Advance every gesture affected by a sample, the recognized ones end up in State.Recognized
+	/// @param Sample Sample taken with the table the detector was initialized with
+	/// @param Previous Digital state of the sample before
+	/// @param State Progress of the controller the sample belongs to
+	void Evaluate(const FSteamInputSample& Sample, const FSteamInputActionBits& Previous, FState& State) const;
+
+	/// Advance the gestures waiting for a hold once per frame, so holds complete on time while no sample arrives
+	/// @param Down Digital state of the last evaluated sample
+	/// @param Time Current time, on the clock of the sample timestamps
+	/// @param State Progress of the controller, the recognized gestures end up in State.Recognized
+	void Tick(const FSteamInputActionBits& Down, double Time, FState& State) const;
+
+	/** Key dispatched for a recognized gesture */
+	const FName& GetGestureName(const int32 GestureIndex) const {return Gestures[GestureIndex].GestureName;}
+
+private:
+	struct FGesture
+	{
+		FName GestureName;
+		int32 FirstStep = 0;
+		int32 NumSteps = 0;
+	};
+
+	struct FStep
+	{
+		ESteamInputGestureStepType Type = ESteamInputGestureStepType::Press;
+		float Duration = 0.0f;
+		float MaxDelay = 0.0f;
+		/** Range of the actions of the step in StepActions */
+		int32 FirstAction = 0;
+		int32 NumActions = 0;
+	};
+
+	/** Words per bitmask, enough for every digital action of the table */
+	int32 NumWords = 0;
+	int32 NumDigital = 0;
+
+	TArray<FGesture> Gestures;
+	TArray<FStep> Steps;
+	/** NumWords per step, the actions of the step */
+	TArray<uint64> StepMasks;
+	/** NumWords per gesture, the actions of all of its steps */
+	TArray<uint64> GestureMasks;
+	/** Digital action indices of every step */
+	TArray<int32> StepActions;
+	/** Gestures using each digital action, those of action I are ActionGestures[ActionGestureStart[I]] up to ActionGestureStart[I + 1] */
+	TArray<int32> ActionGestureStart;
+	TArray<int32> ActionGestures;
+
+	/// Try to match the current step of a gesture against the sample
+	/// @param bOutHolding Set when the gesture waits for a hold to complete and has to be visited on the next sample
+	/// @return true if the gesture completed
+	bool Advance(int32 GestureIndex, const uint64* Down, double Time, FState& State, bool& bOutHolding) const;
+};
@@ -0,0 +1,141 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputHistory.h"
+
+#include "Controller/SteamInputActionTable.h"
+#include "Serialization/Archive.h"
+
+void FSteamInputHistory::Init(const FSteamInputActionTable& Table, const int32 Capacity)
+{
+	Frames.Reset();
+	Frames.SetNum(FMath::Max(Capacity, 0));
+	for (FSteamInputFrame& Frame : Frames)
+	{
+		Frame.Init(Table);
+	}
+
+	LatestTick = 0;
+}
+
+void FSteamInputHistory::Record(const FSteamInputActionTable& Table, const FSteamInputSample& Sample)
+{
+	if (!IsEnabled() || Sample.SampleIndex == 0)
+	{
+		return;
+	}
+
+	//frames are preallocated, quantizing in place keeps recording allocation free
+	Frames[Sample.SampleIndex % Frames.Num()].Quantize(Table, Sample);
+	LatestTick = FMath::Max(LatestTick, Sample.SampleIndex);
+}
+
+void FSteamInputHistory::Store(const FSteamInputFrame& Frame)
+{
+	if (!IsEnabled() || Frame.Tick == 0)
+	{
+		return;
+	}
+
+	Frames[Frame.Tick % Frames.Num()] = Frame;
+	LatestTick = FMath::Max(LatestTick, Frame.Tick);
+}
+
+const FSteamInputFrame* FSteamInputHistory::Find(const uint64 Tick) const
+{
+	if (!IsEnabled() || Tick == 0)
+	{
+		return nullptr;
+	}
+
+	const FSteamInputFrame& Frame = Frames[Tick % Frames.Num()];
+	return Frame.Tick == Tick ? &Frame : nullptr;
+}
+
+uint64 FSteamInputHistory::GetOldestTick() const
+{
+	const uint64 Capacity = Frames.Num();
+	return LatestTick >= Capacity ? LatestTick - Capacity + 1 : 1;
+}
+
+int32 FSteamInputHistory::SerializeRange(FArchive& Ar, const uint64 FirstTick, const uint64 LastTick) const
+{
+	check(Ar.IsSaving());
+
+	TArray<const FSteamInputFrame*, TInlineAllocator<64>> RangeFrames;
+	for (uint64 Tick = FMath::Max(FirstTick, GetOldestTick()); Tick <= LastTick && Tick <= LatestTick; ++Tick)
+	{
+		if (const FSteamInputFrame* Frame = Find(Tick))
+		{
+			RangeFrames.Add(Frame);
+		}
+	}
+
+	uint32 Count = RangeFrames.Num();
+	Ar.SerializeIntPacked(Count);
+	if (Count == 0)
+	{
+		return 0;
+	}
+
+	uint64 BaseTick = RangeFrames[0]->Tick;
+	Ar << BaseTick;
+
+	//the first frame is encoded against an empty frame, every following frame against its predecessor
+	FSteamInputFrame Empty;
+	Empty.Digital.Init(RangeFrames[0]->Digital.Num());
+	Empty.Axes.SetNumZeroed(RangeFrames[0]->Axes.Num());
+
+	const FSteamInputFrame* Baseline = &Empty;
+	for (const FSteamInputFrame* Frame : RangeFrames)
+	{
+		uint32 TickDelta = static_cast<uint32>(Frame->Tick - (Baseline == &Empty ? BaseTick : Baseline->Tick));
+		Ar.SerializeIntPacked(TickDelta);
+
+		Frame->SaveDelta(Ar, *Baseline);
+		Baseline = Frame;
+	}
+
+	return RangeFrames.Num();
+}
+
+bool FSteamInputHistory::DeserializeRange(FArchive& Ar, const FSteamInputActionTable& Table, const int32 MaxFrames, TArray<FSteamInputFrame>& OutFrames)
+{
+	check(Ar.IsLoading());
+
+	uint32 Count = 0;
+	Ar.SerializeIntPacked(Count);
+	if (Count == 0)
+	{
+		return !Ar.IsError();
+	}
+
+	//a range never holds more frames than the history it was written from, anything above is malformed
+	if (Count > static_cast<uint32>(FMath::Max(MaxFrames, 0)))
+	{
+		Ar.SetError();
+		return false;
+	}
+	OutFrames.Reserve(OutFrames.Num() + Count);
+
+	uint64 Tick = 0;
+	Ar << Tick;
+
+	FSteamInputFrame Baseline;
+	Baseline.Init(Table);
+
+	for (uint32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+	{
+		uint32 TickDelta = 0;
+		Ar.SerializeIntPacked(TickDelta);
+		Tick += TickDelta;
+
+		FSteamInputFrame& Frame = OutFrames.AddDefaulted_GetRef();
+		Frame.Init(Table);
+		Frame.LoadDelta(Ar, Baseline);
+		Frame.Tick = Tick;
+
+		Baseline = Frame;
+	}
+
+	return !Ar.IsError();
+}
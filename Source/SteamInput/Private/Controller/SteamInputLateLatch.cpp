@@ -0,0 +1,129 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputLateLatch.h"
+
+#include "Globals.h"
+#include "Settings/SteamInputSettings.h"
+#include "RenderingThread.h"
+#include "SceneView.h"
+
+FSteamInputLateLatch::FSteamInputLateLatch(const USteamInputSettings& Settings)
+	: StickAction(Settings.LateLatchStickAction)
+	, StickRate(Settings.LateLatchStickRate)
+	, GyroSensitivity(Settings.LateLatchGyroSensitivity)
+{
+}
+
+bool FSteamInputLateLatch::Matches(const USteamInputSettings& Settings) const
+{
+	return StickAction == Settings.LateLatchStickAction && StickRate == Settings.LateLatchStickRate && GyroSensitivity == Settings.LateLatchGyroSensitivity;
+}
+
+void FSteamInputLateLatch::WriteGyro(const InputHandle_t Controller, const FVector& RotationDelta)
+{
+	if (Controller != GetTarget())
+	{
+		return;
+	}
+
+	//same axes as the Steam_Gyro keys
+	GyroTotal += FVector2D(RotationDelta.Z, RotationDelta.X);
+	GyroSlot.Write(GyroTotal);
+}
+
+void FSteamInputLateLatch::WriteStick(const InputHandle_t Controller, const FVector2f& Stick, const double Timestamp)
+{
+	if (Controller != GetTarget())
+	{
+		return;
+	}
+
+	//a gap after a stall or a target change would otherwise integrate into a jump
+	const double DeltaTime = LastStickTime > 0.0 ? FMath::Clamp(Timestamp - LastStickTime, 0.0, 0.1) : 0.0;
+	LastStickTime = Timestamp;
+
+	StickTotal += FVector2D(Stick) * StickRate * DeltaTime;
+	StickSlot.Write(StickTotal);
+}
+
+FSteamInputLateLatchAngles FSteamInputLateLatch::Read() const
+{
+	FSteamInputLateLatchAngles Angles;
+	Angles.Gyro = GyroSlot.Read();
+	Angles.Stick = StickSlot.Read();
+	return Angles;
+}
+
+FRotator FSteamInputLateLatch::GetRotationOffset(const FSteamInputLateLatchAngles& GameThread, const FSteamInputLateLatchAngles& Latest) const
+{
+	const FVector2D Offset = (Latest.Gyro - GameThread.Gyro) * GyroSensitivity + (Latest.Stick - GameThread.Stick);
+	return FRotator(Offset.Y, Offset.X, 0.0);
+}
+
+void FSteamInputLateLatch::FSlot::Write(const FVector2D& Value)
+{
+	//odd while writing, readers retry until they see the same even sequence on both sides of their read
+	const uint32 Start = Sequence.load(std::memory_order_relaxed);
+	Sequence.store(Start + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	X.store(Value.X, std::memory_order_relaxed);
+	Y.store(Value.Y, std::memory_order_relaxed);
+
+	Sequence.store(Start + 2, std::memory_order_release);
+}
+
+FVector2D FSteamInputLateLatch::FSlot::Read() const
+{
+	FVector2D Value;
+	uint32 Start;
+	uint32 End;
+	do
+	{
+		Start = Sequence.load(std::memory_order_acquire);
+		Value.X = X.load(std::memory_order_relaxed);
+		Value.Y = Y.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		End = Sequence.load(std::memory_order_relaxed);
+	}
+	while (Start != End || (Start & 1) != 0);
+
+	return Value;
+}
+
+FSteamInputLateLatchExtension::FSteamInputLateLatchExtension(const FAutoRegister& AutoRegister, const TSharedRef<FSteamInputLateLatch, ESPMode::ThreadSafe>& InLateLatch)
+	: FSceneViewExtensionBase(AutoRegister)
+	, LateLatch(InLateLatch)
+{
+}
+
+void FSteamInputLateLatchExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
+{
+	//the render thread may still work on the previous frame, hand the angles over in order with the family
+	ENQUEUE_RENDER_COMMAND(SteamInputLateLatch)([Extension = StaticCastSharedRef<FSteamInputLateLatchExtension>(AsShared()), Angles = LateLatch->GetGameThreadAngles()](FRHICommandListImmediate&)
+	{
+		Extension->RenderThreadAngles = Angles;
+	});
+}
+
+void FSteamInputLateLatchExtension::PreRenderView_RenderThread(FRDGBuilder& GraphBuilder, FSceneView& InView)
+{
+	if (!InView.bIsGameView || InView.bIsSceneCapture || !InView.Family || InView.Family->Views.Num() != 1)
+	{
+		return;
+	}
+
+	const FRotator Offset = LateLatch->GetRotationOffset(RenderThreadAngles, LateLatch->Read());
+	if (Offset.IsNearlyZero())
+	{
+		return;
+	}
+
+	InView.ViewRotation += Offset;
+	InView.UpdateViewMatrix();
+}
+
+bool FSteamInputLateLatchExtension::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
+{
+	return LateLatch->GetTarget() != 0;
+}
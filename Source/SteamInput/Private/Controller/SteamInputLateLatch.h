@@ -0,0 +1,114 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneViewExtension.h"
+#include "SteamInputTypes.h"
+
+#include <atomic>
+
+class USteamInputSettings;
+
+/** Camera rotation in degrees accumulated by an FSteamInputLateLatch, yaw in X and pitch in Y. Only the difference between two reads means anything */
+struct FSteamInputLateLatchAngles
+{
+	FVector2D Gyro = FVector2D::ZeroVector;
+	FVector2D Stick = FVector2D::ZeroVector;
+};
+
+/**
+ * Newest gyro and stick motion of the controller driving the camera, written by the samplers and read by the render thread without locks.
+ * Both inputs are integrated into ever growing angles. The game thread remembers the angles it simulated with, the render thread turns
+ * the view by whatever was integrated since, which hides up to a frame of aim latency without changing the simulation.
+ */
+class FSteamInputLateLatch
+{
+public:
+	explicit FSteamInputLateLatch(const USteamInputSettings& Settings);
+
+	/** Whether the latch was created from the current settings */
+	bool Matches(const USteamInputSettings& Settings) const;
+
+	/// Pick the controller driving the camera, writes for any other controller are ignored. Game thread only
+	void SetTarget(InputHandle_t Controller) {Target.store(Controller, std::memory_order_relaxed);}
+	InputHandle_t GetTarget() const {return Target.load(std::memory_order_relaxed);}
+	FName GetStickAction() const {return StickAction;}
+
+	/// Add the rotation of a single gyro reading, only called from the action sampler thread after it read the motion sensors
+	/// @param RotationDelta Degrees, X is pitch, Y is roll and Z is yaw as in FSteamInputMotion
+	void WriteGyro(InputHandle_t Controller, const FVector& RotationDelta);
+	/// Integrate a stick sample, only called from the action sampler thread
+	/// @param Stick Deflection of the look action
+	/// @param Timestamp FPlatformTime::Seconds() the sample was taken at
+	void WriteStick(InputHandle_t Controller, const FVector2f& Stick, double Timestamp);
+
+	/** Newest angles, safe to call from any thread */
+	FSteamInputLateLatchAngles Read() const;
+
+	/// Remember the angles the game thread simulated the current frame with, called once the input of the frame was dispatched
+	void LatchGameThread() {GameThreadAngles = Read();}
+	const FSteamInputLateLatchAngles& GetGameThreadAngles() const {return GameThreadAngles;}
+
+	/// Rotation the game thread has not seen yet
+	/// @param GameThread Angles the view was set up with
+	/// @param Latest Angles to render with
+	FRotator GetRotationOffset(const FSteamInputLateLatchAngles& GameThread, const FSteamInputLateLatchAngles& Latest) const;
+
+private:
+	/** Seqlock around a pair of angles, single writer */
+	class FSlot
+	{
+	public:
+		void Write(const FVector2D& Value);
+		FVector2D Read() const;
+
+	private:
+		std::atomic<uint32> Sequence{0};
+		std::atomic<double> X{0.0};
+		std::atomic<double> Y{0.0};
+	};
+
+	FName StickAction;
+	FVector2D StickRate;
+	FVector2D GyroSensitivity;
+
+	std::atomic<InputHandle_t> Target{0};
+
+	FSlot GyroSlot;
+	FSlot StickSlot;
+
+	/** Running totals, each only touched by the thread writing the matching slot */
+	FVector2D GyroTotal = FVector2D::ZeroVector;
+	FVector2D StickTotal = FVector2D::ZeroVector;
+	double LastStickTime = 0.0;
+
+	/** Only touched by the game thread */
+	FSteamInputLateLatchAngles GameThreadAngles;
+};
+
+/**
+ * Applies an FSteamInputLateLatch to the game view right before the render thread builds it.
+ * Only single view families are touched, with split screen there is no telling which view belongs to the latched controller.
+ */
+class FSteamInputLateLatchExtension : public FSceneViewExtensionBase
+{
+public:
+	FSteamInputLateLatchExtension(const FAutoRegister& AutoRegister, const TSharedRef<FSteamInputLateLatch, ESPMode::ThreadSafe>& InLateLatch);
+
+	//~ Begin ISceneViewExtension Interface
+	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override {}
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
+	virtual void PreRenderView_RenderThread(FRDGBuilder& GraphBuilder, FSceneView& InView) override;
+	//~ End ISceneViewExtension Interface
+
+protected:
+	virtual bool IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const override;
+
+private:
+	TSharedRef<FSteamInputLateLatch, ESPMode::ThreadSafe> LateLatch;
+
+	/** Game thread angles of the family being rendered, only touched by the render thread */
+	FSteamInputLateLatchAngles RenderThreadAngles;
+};
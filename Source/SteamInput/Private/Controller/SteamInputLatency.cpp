@@ -0,0 +1,183 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputLatency.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/ScopeLock.h"
+#include "Rendering/SlateRenderer.h"
+#include "RHIFwd.h"
+
+void FSteamInputLatencyHistogram::Add(const double Seconds)
+{
+	const int32 Bucket = FMath::Clamp(FMath::FloorToInt32(Seconds / BucketSeconds), 0, NumBuckets - 1);
+	++Buckets[Bucket];
+	++Count;
+	TotalSeconds += Seconds;
+	MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+void FSteamInputLatencyHistogram::Reset()
+{
+	*this = FSteamInputLatencyHistogram();
+}
+
+double FSteamInputLatencyHistogram::GetPercentile(const double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint64 Target = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 1.0) * Count)));
+	uint64 Cumulative = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Cumulative += Buckets[Bucket];
+		if (Cumulative >= Target)
+		{
+			//upper edge of the bucket, never more than what was actually measured
+			return FMath::Min((Bucket + 1) * BucketSeconds, MaxSeconds);
+		}
+	}
+
+	return MaxSeconds;
+}
+
+FSteamInputLatencyTracker& FSteamInputLatencyTracker::Get()
+{
+	static FSteamInputLatencyTracker Tracker;
+	return Tracker;
+}
+
+void FSteamInputLatencyTracker::SetEnabled(const bool bInEnabled)
+{
+	if (bEnabled == bInEnabled)
+	{
+		return;
+	}
+
+	bEnabled = bInEnabled;
+
+	if (!FSlateApplication::IsInitialized() || !FSlateApplication::Get().GetRenderer())
+	{
+		return;
+	}
+
+	FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer();
+	if (bEnabled)
+	{
+		PresentHandle = Renderer->OnBackBufferReadyToPresent().AddLambda([this](SWindow&, const FTextureRHIRef&) {OnFramePresented();});
+	}
+	else
+	{
+		Renderer->OnBackBufferReadyToPresent().Remove(PresentHandle);
+		PresentHandle.Reset();
+
+		FScopeLock Lock(&Mutex);
+		AwaitingPresent.Reset();
+	}
+}
+
+void FSteamInputLatencyTracker::Stamp(const FName Key, const uint64 SampleIndex, const double OriginTime)
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&Mutex);
+
+	FStamp& NewStamp = LatestStamps.FindOrAdd(Key);
+	NewStamp = FStamp();
+	NewStamp.SampleIndex = SampleIndex;
+	NewStamp.OriginTime = OriginTime;
+	NewStamp.GameFrame = GFrameCounter;
+
+	Record(NewStamp, ESteamInputLatencyPath::Dispatch, FPlatformTime::Seconds());
+
+	if (PresentHandle.IsValid())
+	{
+		AwaitingPresent.Add(NewStamp);
+	}
+}
+
+void FSteamInputLatencyTracker::Observe(const FName Key, const ESteamInputLatencyPath Path)
+{
+	if (!bEnabled || Path == ESteamInputLatencyPath::Num)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&Mutex);
+
+	if (FStamp* LatestStamp = LatestStamps.Find(Key))
+	{
+		Record(*LatestStamp, Path, FPlatformTime::Seconds());
+	}
+}
+
+FSteamInputLatencyHistogram FSteamInputLatencyTracker::GetHistogram(const ESteamInputLatencyPath Path) const
+{
+	FScopeLock Lock(&Mutex);
+	return Path != ESteamInputLatencyPath::Num ? Histograms[static_cast<int32>(Path)] : FSteamInputLatencyHistogram();
+}
+
+void FSteamInputLatencyTracker::Reset()
+{
+	FScopeLock Lock(&Mutex);
+
+	for (FSteamInputLatencyHistogram& Histogram : Histograms)
+	{
+		Histogram.Reset();
+	}
+	LatestStamps.Reset();
+	AwaitingPresent.Reset();
+}
+
+void FSteamInputLatencyTracker::Report(FOutputDevice& Ar, const FString& Label) const
+{
+	FScopeLock Lock(&Mutex);
+
+	Ar.Logf(TEXT("Steam Input latency %s:"), *Label);
+	for (int32 Path = 0; Path < static_cast<int32>(ESteamInputLatencyPath::Num); ++Path)
+	{
+		const FSteamInputLatencyHistogram& Histogram = Histograms[Path];
+		if (Histogram.Count == 0)
+		{
+			continue;
+		}
+
+		Ar.Logf(TEXT("  %-14s %6llu events  mean %6.2fms  p50 %6.2fms  p90 %6.2fms  p99 %6.2fms  max %6.2fms"),
+			*StaticEnum<ESteamInputLatencyPath>()->GetNameStringByValue(Path), Histogram.Count, Histogram.GetMean() * 1000.0,
+			Histogram.GetPercentile(0.5) * 1000.0, Histogram.GetPercentile(0.9) * 1000.0, Histogram.GetPercentile(0.99) * 1000.0, Histogram.MaxSeconds * 1000.0);
+	}
+}
+
+void FSteamInputLatencyTracker::OnFramePresented()
+{
+	const double Now = FPlatformTime::Seconds();
+	const uint64 PresentedFrame = GFrameCounterRenderThread;
+
+	FScopeLock Lock(&Mutex);
+
+	for (int32 Index = AwaitingPresent.Num() - 1; Index >= 0; --Index)
+	{
+		if (AwaitingPresent[Index].GameFrame <= PresentedFrame)
+		{
+			Record(AwaitingPresent[Index], ESteamInputLatencyPath::Presented, Now);
+			AwaitingPresent.RemoveAtSwap(Index, EAllowShrinking::No);
+		}
+	}
+}
+
+void FSteamInputLatencyTracker::Record(FStamp& InStamp, const ESteamInputLatencyPath Path, const double Now)
+{
+	const uint8 PathBit = 1 << static_cast<int32>(Path);
+	if (InStamp.ObservedPaths & PathBit)
+	{
+		return;
+	}
+
+	InStamp.ObservedPaths |= PathBit;
+	Histograms[static_cast<int32>(Path)].Add(FMath::Max(Now - InStamp.OriginTime, 0.0));
+}
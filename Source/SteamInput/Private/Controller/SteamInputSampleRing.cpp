@@ -0,0 +1,67 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputSampleRing.h"
+
+#include "Misc/ScopeLock.h"
+
+FSteamInputSampleRing::FSteamInputSampleRing(const int32 Capacity)
+{
+	Slots.SetNum(FMath::Max(Capacity, 1));
+}
+
+void FSteamInputSampleRing::Write(const FSteamInputSample& Sample)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Slots[Sample.SampleIndex % Slots.Num()] = Sample;
+	LatestIndex = FMath::Max(LatestIndex, Sample.SampleIndex);
+}
+
+bool FSteamInputSampleRing::Read(const uint64 SampleIndex, FSteamInputSample& OutSample) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FSteamInputSample& Slot = Slots[SampleIndex % Slots.Num()];
+	if (SampleIndex == 0 || Slot.SampleIndex != SampleIndex)
+	{
+		return false;
+	}
+
+	OutSample = Slot;
+	return true;
+}
+
+int32 FSteamInputSampleRing::ReadSince(uint64& InOutLastIndex, TArray<FSteamInputSample>& OutSamples) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (LatestIndex <= InOutLastIndex)
+	{
+		return 0;
+	}
+
+	//anything older than the ring capacity has been overwritten already, skip ahead
+	const uint64 Capacity = Slots.Num();
+	const uint64 FirstIndex = LatestIndex >= Capacity ? FMath::Max(InOutLastIndex + 1, LatestIndex - Capacity + 1) : InOutLastIndex + 1;
+
+	int32 Count = 0;
+	for (uint64 Index = FirstIndex; Index <= LatestIndex; ++Index)
+	{
+		//sample indices are shared between controllers, a gap means this controller was not connected for that sample
+		const FSteamInputSample& Slot = Slots[Index % Capacity];
+		if (Slot.SampleIndex == Index)
+		{
+			OutSamples.Add(Slot);
+			++Count;
+		}
+	}
+
+	InOutLastIndex = LatestIndex;
+	return Count;
+}
+
+uint64 FSteamInputSampleRing::GetLatestIndex() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return LatestIndex;
+}
@@ -0,0 +1,40 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Controller/SteamInputSample.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Fixed capacity ring of samples for a single controller, written by the sampler thread and read from the game thread.
+ * Samples are addressed by their SampleIndex so any of the last Capacity samples can be read in O(1).
+ */
+class FSteamInputSampleRing
+{
+public:
+	explicit FSteamInputSampleRing(int32 Capacity);
+
+	/** Store a sample, overwriting the oldest one once the ring is full */
+	void Write(const FSteamInputSample& Sample);
+
+	/// Read a single sample
+	/// @param SampleIndex Index of the sample to read
+	/// @param OutSample Receives the sample
+	/// @return false if the sample was never written for this controller or has already been overwritten
+	bool Read(uint64 SampleIndex, FSteamInputSample& OutSample) const;
+
+	/// Append every sample newer than InOutLastIndex to OutSamples, oldest first
+	/// @param InOutLastIndex Index of the last sample the caller has seen, updated to the newest sample appended
+	/// @param OutSamples Array the samples get appended to
+	/// @return Amount of samples appended
+	int32 ReadSince(uint64& InOutLastIndex, TArray<FSteamInputSample>& OutSamples) const;
+
+	uint64 GetLatestIndex() const;
+	int32 GetCapacity() const {return Slots.Num();}
+
+private:
+	mutable FCriticalSection Lock;
+	TArray<FSteamInputSample> Slots;
+	uint64 LatestIndex = 0;
+};
@@ -0,0 +1,87 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputScriptedSource.h"
+
+#include "Controller/SteamInputActionTable.h"
+
+FSteamInputScriptedSource::FSteamInputScriptedSource(const int32 InDigitalIndex, const double InInterval, const int32 InSeed)
+	: DigitalIndex(InDigitalIndex)
+	, Interval(FMath::Max(InInterval, 0.001))
+	, Seed(InSeed)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+void FSteamInputScriptedSource::RunFrame()
+{
+	if (!EventHandler)
+	{
+		return;
+	}
+
+	//report every toggle since the last call with the time it actually happened
+	const int64 Toggles = CountToggles(FPlatformTime::Seconds());
+	for (; ReportedToggles < Toggles; ++ReportedToggles)
+	{
+		FSteamInputActionEvent Event;
+		Event.Controller = ControllerHandle;
+		Event.ActionIndex = DigitalIndex;
+		Event.bState = (ReportedToggles & 1) == 0;
+		Event.Timestamp = GetToggleTime(ReportedToggles);
+		EventHandler(Event);
+	}
+}
+
+int32 FSteamInputScriptedSource::GetConnectedControllers(InputHandle_t* OutControllers)
+{
+	OutControllers[0] = ControllerHandle;
+	return 1;
+}
+
+void FSteamInputScriptedSource::PollSample(const FSteamInputActionTable& Table, const InputHandle_t Controller, FSteamInputSample& OutSample)
+{
+	if (Controller == ControllerHandle && Table.DigitalActions.IsValidIndex(DigitalIndex))
+	{
+		//odd amount of toggles means the action is held
+		OutSample.Digital.Set(DigitalIndex, (CountToggles(FPlatformTime::Seconds()) & 1) != 0);
+	}
+}
+
+bool FSteamInputScriptedSource::SetActionEventHandler(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& Table,
+	TFunction<void(const FSteamInputActionEvent&)> Handler)
+{
+	EventHandler = Table.IsValid() && Table->DigitalActions.IsValidIndex(DigitalIndex) ? MoveTemp(Handler) : nullptr;
+	ReportedToggles = CountToggles(FPlatformTime::Seconds());
+	return true;
+}
+
+double FSteamInputScriptedSource::GetChangeTime(const InputHandle_t Controller, const bool bAnalog, const int32 ActionIndex) const
+{
+	if (Controller != ControllerHandle || bAnalog || ActionIndex != DigitalIndex)
+	{
+		return 0.0;
+	}
+
+	const int64 Toggles = CountToggles(FPlatformTime::Seconds());
+	return Toggles > 0 ? GetToggleTime(Toggles - 1) : 0.0;
+}
+
+double FSteamInputScriptedSource::GetToggleTime(const int64 Toggle) const
+{
+	//jitter of up to half an interval, derived from the toggle number so every poll agrees on it
+	const uint32 Hash = HashCombineFast(static_cast<uint32>(Seed), GetTypeHash(Toggle));
+	const double Jitter = (Hash & 0xFFFF) / 65536.0 * Interval * 0.5;
+	return StartTime + (Toggle + 1) * Interval + Jitter;
+}
+
+int64 FSteamInputScriptedSource::CountToggles(const double Time) const
+{
+	//toggle N happens within [N + 1, N + 1.5) intervals after the start
+	const int64 Candidate = FMath::FloorToInt64((Time - StartTime) / Interval);
+	if (Candidate <= 0)
+	{
+		return 0;
+	}
+
+	return Time >= GetToggleTime(Candidate - 1) ? Candidate : Candidate - 1;
+}
@@ -0,0 +1,45 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Controller/SteamInputSource.h"
+
+/**
+ * Fake ISteamInputSource exposing a single controller that toggles one digital action on a fixed schedule.
+ * Every toggle is offset by a deterministic jitter so it does not line up with frames or the sampler, and its exact time is
+ * reported through GetChangeTime so latency can be measured from the change rather than from the sample.
+ * The state is a pure function of time, which keeps the source lock free when it is polled from the sampler thread.
+ */
+class FSteamInputScriptedSource : public ISteamInputSource
+{
+public:
+	/** Handle of the fake controller */
+	static constexpr InputHandle_t ControllerHandle = 0x5C819700000001ull;
+
+	/// @param InDigitalIndex Digital action to toggle
+	/// @param InInterval Seconds between two toggles
+	/// @param InSeed Seed of the toggle jitter
+	FSteamInputScriptedSource(int32 InDigitalIndex, double InInterval, int32 InSeed = 0);
+
+	virtual void RunFrame() override;
+	virtual int32 GetConnectedControllers(InputHandle_t* OutControllers) override;
+	virtual void PollSample(const FSteamInputActionTable& Table, InputHandle_t Controller, FSteamInputSample& OutSample) override;
+	virtual bool SetActionEventHandler(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& Table, TFunction<void(const FSteamInputActionEvent&)> Handler) override;
+	virtual double GetChangeTime(InputHandle_t Controller, bool bAnalog, int32 ActionIndex) const override;
+
+private:
+	/// Time of toggle number Toggle
+	double GetToggleTime(int64 Toggle) const;
+	/// Amount of toggles that happened up to Time
+	int64 CountToggles(double Time) const;
+
+	int32 DigitalIndex;
+	double Interval;
+	int32 Seed;
+	double StartTime;
+
+	/** Only touched from RunFrame */
+	TFunction<void(const FSteamInputActionEvent&)> EventHandler;
+	int64 ReportedToggles = 0;
+};
@@ -0,0 +1,235 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputSnapshot.h"
+
+#include "Globals.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Settings/SteamInputSettings.h"
+
+namespace
+{
+	int32 GetMaxQuantized(const int32 Precision)
+	{
+		return (1 << (FMath::Clamp(Precision, 4, 16) - 1)) - 1;
+	}
+
+	/** Quantize onto [-MaxQuantized, MaxQuantized], MIN_int16 included */
+	int32 EncodeAxis(const int16 Value, const int32 MaxQuantized)
+	{
+		return FMath::Clamp(FMath::RoundToInt32(static_cast<float>(Value) * MaxQuantized / MAX_int16), -MaxQuantized, MaxQuantized);
+	}
+
+	int16 DecodeAxis(const int32 Quantized, const int32 MaxQuantized)
+	{
+		return static_cast<int16>(FMath::RoundToInt32(static_cast<float>(Quantized) * MAX_int16 / MaxQuantized));
+	}
+}
+
+bool FSteamInputSnapshot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	const TSharedRef<const FSteamInputActionTable, ESPMode::ThreadSafe> Layout = GetLayout();
+	const int32 NumAxes = Layout->AnalogActions.Num() * 2;
+	const int32 MaxQuantized = GetMaxQuantized(GetDefault<USteamInputSettings>()->SnapshotAxisPrecision);
+
+	if (Ar.IsSaving())
+	{
+		if (Frame.Digital.Num() != Layout->DigitalActions.Num() || Frame.Axes.Num() != NumAxes)
+		{
+			//the actions changed since the frame was taken, send an empty frame rather than a misaligned one
+			UE_LOG(SteamInputLog, Warning, TEXT("Input snapshot for tick %llu does not match the configured actions"), Tick);
+			Frame.Init(*Layout);
+			Frame.Tick = Tick;
+		}
+
+		if (Baseline.Digital.Num() != Frame.Digital.Num() || Baseline.Axes.Num() != Frame.Axes.Num())
+		{
+			BaselineTick = 0;
+		}
+	}
+	else
+	{
+		Frame.Init(*Layout);
+		ReceivedAxes.Init(NumAxes);
+	}
+
+	Ar.SerializeIntPacked64(Tick);
+	Frame.Tick = Tick;
+
+	uint8 bDelta = BaselineTick != 0 && BaselineTick < Tick;
+	Ar.SerializeBits(&bDelta, 1);
+	if (bDelta)
+	{
+		uint64 BaselineOffset = Tick - BaselineTick;
+		Ar.SerializeIntPacked64(BaselineOffset);
+		BaselineTick = Tick - BaselineOffset;
+	}
+	else
+	{
+		BaselineTick = 0;
+	}
+
+	//when loading, changes are read against an empty frame and the baseline is applied afterwards in ResolveBaseline
+	FSteamInputFrame Empty;
+	Empty.Init(*Layout);
+	const FSteamInputFrame& Reference = Ar.IsSaving() && bDelta ? Baseline : Empty;
+
+	//digital actions, a single bit when no button changed
+	uint8 bDigitalChanged = Ar.IsSaving() && Frame.Digital != Reference.Digital;
+	Ar.SerializeBits(&bDigitalChanged, 1);
+	if (bDigitalChanged)
+	{
+		for (int32 Word = 0; Word < Frame.Digital.Words.Num(); ++Word)
+		{
+			uint64 Xor = Ar.IsSaving() ? Frame.Digital.Words[Word] ^ Reference.Digital.Words[Word] : 0;
+			Ar.SerializeBits(&Xor, FMath::Min(64, Frame.Digital.Num() - Word * 64));
+			Frame.Digital.Words[Word] = Reference.Digital.Words[Word] ^ Xor;
+		}
+	}
+
+	//axes, a changed bit each followed by the value at the configured precision
+	for (int32 Axis = 0; Axis < NumAxes; ++Axis)
+	{
+		uint8 bAxisChanged = Ar.IsSaving() && Frame.Axes[Axis] != Reference.Axes[Axis];
+		Ar.SerializeBits(&bAxisChanged, 1);
+		if (!bAxisChanged)
+		{
+			continue;
+		}
+
+		if (Layout->AnalogActions[Axis / 2].KeyType == EKeyType::MouseInput)
+		{
+			uint32 Value = FSteamInputFrame::ZigZagEncode(Frame.Axes[Axis]);
+			Ar.SerializeIntPacked(Value);
+			Frame.Axes[Axis] = static_cast<int16>(FSteamInputFrame::ZigZagDecode(Value));
+		}
+		else
+		{
+			//offset into [0, 2 * MaxQuantized], SerializeInt takes the exclusive upper bound
+			uint32 Value = EncodeAxis(Frame.Axes[Axis], MaxQuantized) + MaxQuantized;
+			Ar.SerializeInt(Value, MaxQuantized * 2 + 1);
+			Frame.Axes[Axis] = DecodeAxis(static_cast<int32>(Value) - MaxQuantized, MaxQuantized);
+		}
+
+		if (Ar.IsLoading())
+		{
+			ReceivedAxes.Set(Axis, true);
+		}
+	}
+
+	if (Ar.IsLoading())
+	{
+		bPendingBaseline = bDelta != 0;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FSteamInputSnapshot::ResolveBaseline(const FSteamInputFrame& InBaseline)
+{
+	if (!bPendingBaseline)
+	{
+		return true;
+	}
+
+	if (InBaseline.Digital.Num() != Frame.Digital.Num() || InBaseline.Axes.Num() != Frame.Axes.Num())
+	{
+		return false;
+	}
+
+	for (int32 Word = 0; Word < Frame.Digital.Words.Num(); ++Word)
+	{
+		Frame.Digital.Words[Word] ^= InBaseline.Digital.Words[Word];
+	}
+
+	for (int32 Axis = 0; Axis < Frame.Axes.Num(); ++Axis)
+	{
+		if (!ReceivedAxes.Get(Axis))
+		{
+			Frame.Axes[Axis] = InBaseline.Axes[Axis];
+		}
+	}
+
+	bPendingBaseline = false;
+	return true;
+}
+
+TSharedRef<const FSteamInputActionTable, ESPMode::ThreadSafe> FSteamInputSnapshot::GetLayout()
+{
+	//only touched from the game thread, which is where replication serializes
+	static TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> Layout;
+
+	const USteamInputSettings* Settings = GetDefault<USteamInputSettings>();
+	if (!Layout.IsValid() || Layout->Revision != Settings->GetHandleRevision())
+	{
+		Layout = FSteamInputActionTable::Build(*Settings);
+	}
+
+	return Layout.ToSharedRef();
+}
+
+int16 FSteamInputSnapshot::ReduceAxis(const int16 Value, const int32 Precision)
+{
+	const int32 MaxQuantized = GetMaxQuantized(Precision);
+	return DecodeAxis(EncodeAxis(Value, MaxQuantized), MaxQuantized);
+}
+
+void FSteamInputSnapshotBuffer::Init(const int32 Capacity)
+{
+	Frames.Init(*FSteamInputSnapshot::GetLayout(), Capacity);
+	AcknowledgedTick = 0;
+}
+
+FSteamInputSnapshot FSteamInputSnapshotBuffer::MakeSnapshot(const FSteamInputFrame& InFrame)
+{
+	const TSharedRef<const FSteamInputActionTable, ESPMode::ThreadSafe> Layout = FSteamInputSnapshot::GetLayout();
+	const int32 Precision = GetDefault<USteamInputSettings>()->SnapshotAxisPrecision;
+
+	FSteamInputSnapshot Snapshot;
+	Snapshot.Tick = InFrame.Tick;
+	Snapshot.Frame = InFrame;
+
+	//reduce the axes now so the stored frame is exactly what the receiver will reconstruct
+	if (Snapshot.Frame.Axes.Num() == Layout->AnalogActions.Num() * 2)
+	{
+		for (int32 Axis = 0; Axis < Snapshot.Frame.Axes.Num(); ++Axis)
+		{
+			if (Layout->AnalogActions[Axis / 2].KeyType != EKeyType::MouseInput)
+			{
+				Snapshot.Frame.Axes[Axis] = FSteamInputSnapshot::ReduceAxis(Snapshot.Frame.Axes[Axis], Precision);
+			}
+		}
+	}
+
+	if (const FSteamInputFrame* Acknowledged = Frames.Find(AcknowledgedTick); Acknowledged && AcknowledgedTick < InFrame.Tick)
+	{
+		Snapshot.BaselineTick = AcknowledgedTick;
+		Snapshot.Baseline = *Acknowledged;
+	}
+
+	Frames.Store(Snapshot.Frame);
+	return Snapshot;
+}
+
+void FSteamInputSnapshotBuffer::Acknowledge(const uint64 Tick)
+{
+	AcknowledgedTick = FMath::Max(AcknowledgedTick, Tick);
+}
+
+bool FSteamInputSnapshotBuffer::Receive(FSteamInputSnapshot& Snapshot)
+{
+	if (Snapshot.NeedsBaseline())
+	{
+		const FSteamInputFrame* SnapshotBaseline = Frames.Find(Snapshot.BaselineTick);
+		if (!SnapshotBaseline || !Snapshot.ResolveBaseline(*SnapshotBaseline))
+		{
+			return false;
+		}
+	}
+
+	Frames.Store(Snapshot.Frame);
+
+	//on the receiving side this is the newest tick to report back to the sender
+	AcknowledgedTick = FMath::Max(AcknowledgedTick, Snapshot.Tick);
+	return true;
+}
@@ -0,0 +1,136 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Controller/SteamInputSource.h"
+
+#include "Controller/FSteamInputSampler.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Profiling/SteamIPCStats.h"
+#include "Misc/ScopeLock.h"
+#include "SteamCore.h"
+#include "steam/isteaminput.h"
+
+FSteamInputLiveSource::FSteamInputLiveSource()
+	: RunFrameLock(FSteamCoreModule::Get().GetRunFrameLock())
+{
+}
+
+TSharedRef<ISteamInputSource, ESPMode::ThreadSafe> FSteamInputLiveSource::Get()
+{
+	static TSharedRef<ISteamInputSource, ESPMode::ThreadSafe> Source = MakeShared<FSteamInputLiveSource, ESPMode::ThreadSafe>();
+	return Source;
+}
+
+void FSteamInputLiveSource::RunFrame()
+{
+	if (ISteamInput* Input = SteamInput())
+	{
+		FScopeLock Lock(&RunFrameLock);
+		STEAM_IPC_CALL(Input, Input, RunFrame);
+	}
+}
+
+int32 FSteamInputLiveSource::GetConnectedControllers(InputHandle_t* OutControllers)
+{
+	ISteamInput* Input = SteamInput();
+	return Input ? STEAM_IPC_CALL(Input, Input, GetConnectedControllers, OutControllers) : 0;
+}
+
+void FSteamInputLiveSource::PollSample(const FSteamInputActionTable& Table, const InputHandle_t Controller, FSteamInputSample& OutSample)
+{
+	TSharedPtr<const FSteamInputPollList, ESPMode::ThreadSafe> PollList;
+	{
+		FScopeLock Lock(&PollListLock);
+		PollList = PollLists.FindRef(Controller);
+	}
+
+	FSteamInputSampler::PollSample(Table, PollList.Get(), Controller, OutSample);
+}
+
+void FSteamInputLiveSource::SetPollList(const InputHandle_t Controller, const TSharedPtr<const FSteamInputPollList, ESPMode::ThreadSafe>& PollList)
+{
+	FScopeLock Lock(&PollListLock);
+	if (PollList.IsValid())
+	{
+		PollLists.Add(Controller, PollList);
+	}
+	else
+	{
+		PollLists.Remove(Controller);
+	}
+}
+
+bool FSteamInputLiveSource::SetActionEventHandler(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& Table,
+	TFunction<void(const FSteamInputActionEvent&)> Handler)
+{
+	ISteamInput* Input = SteamInput();
+	if (!Input)
+	{
+		return false;
+	}
+
+	{
+		FScopeLock Lock(&EventLock);
+
+		EventHandler = MoveTemp(Handler);
+		DigitalIndexByHandle.Reset();
+		AnalogIndexByHandle.Reset();
+
+		if (EventHandler && Table.IsValid())
+		{
+			for (int32 Index = 0; Index < Table->DigitalActions.Num(); ++Index)
+			{
+				DigitalIndexByHandle.Add(Table->DigitalActions[Index].Handle, Index);
+			}
+
+			for (int32 Index = 0; Index < Table->AnalogActions.Num(); ++Index)
+			{
+				AnalogIndexByHandle.Add(Table->AnalogActions[Index].Handle, Index);
+			}
+		}
+	}
+
+	STEAM_IPC_CALL(Input, Input, EnableActionEventCallbacks, EventHandler ? &FSteamInputLiveSource::OnSteamActionEvent : nullptr);
+	return true;
+}
+
+void FSteamInputLiveSource::OnSteamActionEvent(SteamInputActionEvent_t* Event)
+{
+	//called from within ISteamInput::RunFrame, on whichever thread pumps the Steam callbacks
+	FSteamInputLiveSource& Source = static_cast<FSteamInputLiveSource&>(*Get());
+	FScopeLock Lock(&Source.EventLock);
+
+	if (!Event || !Source.EventHandler)
+	{
+		return;
+	}
+
+	FSteamInputActionEvent ActionEvent;
+	ActionEvent.Controller = Event->controllerHandle;
+	ActionEvent.Timestamp = FPlatformTime::Seconds();
+
+	if (Event->eEventType == ESteamInputActionEventType_DigitalAction)
+	{
+		const int32* Index = Source.DigitalIndexByHandle.Find(Event->x.digitalAction.actionHandle);
+		if (!Index)
+		{
+			return;
+		}
+
+		ActionEvent.ActionIndex = *Index;
+		ActionEvent.bState = Event->x.digitalAction.digitalActionData.bState;
+	}
+	else
+	{
+		const int32* Index = Source.AnalogIndexByHandle.Find(Event->x.analogAction.actionHandle);
+		if (!Index)
+		{
+			return;
+		}
+
+		ActionEvent.ActionIndex = *Index;
+		ActionEvent.bAnalog = true;
+		ActionEvent.Value = FVector2f(Event->x.analogAction.analogActionData.x, Event->x.analogAction.analogActionData.y);
+	}
+
+	Source.EventHandler(ActionEvent);
+}
@@ -0,0 +1,98 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SteamInputTypes.h"
+
+struct FSteamInputActionTable;
+struct FSteamInputPollList;
+struct FSteamInputSample;
+
+/** Change of a single action, reported by an ISteamInputSource while action events are enabled */
+struct FSteamInputActionEvent
+{
+	InputHandle_t Controller = 0;
+	/** Index into the digital or analog actions of the table the events were enabled with */
+	int32 ActionIndex = INDEX_NONE;
+	bool bAnalog = false;
+	bool bState = false;
+	FVector2f Value = FVector2f::ZeroVector;
+	/** FPlatformTime::Seconds() at which the change was reported */
+	double Timestamp = 0.0;
+};
+
+/**
+ * Provides controller state to FSteamInputController and FSteamInputSampler.
+ * The live source reads SteamInput(), other sources drive the regular dispatch path from a script or a recording.
+ * RunFrame, GetConnectedControllers and PollSample are called from the sampler thread while the sampling mode is FixedRate.
+ */
+class ISteamInputSource
+{
+public:
+	virtual ~ISteamInputSource() = default;
+
+	/// Pull the latest state, action events are delivered from within this call
+	virtual void RunFrame() {}
+
+	/// @param OutControllers Receives up to STEAM_INPUT_MAX_COUNT controllers
+	/// @return Amount of controllers written
+	virtual int32 GetConnectedControllers(InputHandle_t* OutControllers) = 0;
+
+	/// Poll the state of all actions in the table for a single controller
+	/// @param OutSample Sample to write the state into, must have been initialized with the same table
+	virtual void PollSample(const FSteamInputActionTable& Table, InputHandle_t Controller, FSteamInputSample& OutSample) = 0;
+
+	/// Restrict PollSample to the actions that can fire for the action set and layers active on a controller
+	/// @param PollList Actions to poll, null to poll every action again
+	virtual void SetPollList(InputHandle_t Controller, const TSharedPtr<const FSteamInputPollList, ESPMode::ThreadSafe>& PollList) {}
+
+	/// Report action changes through Handler instead of being polled, a null handler disables the events again
+	/// @param Table Actions the indices of the events refer to
+	/// @return false if the source can't report events
+	virtual bool SetActionEventHandler(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& Table, TFunction<void(const FSteamInputActionEvent&)> Handler) = 0;
+
+	/// Whether the source hands out whole samples through ConsumeSamples, such sources are never sampled or asked for action events
+	virtual bool ProvidesSamples() const {return false;}
+
+	/// Append every sample of a controller that became due during the last RunFrame
+	/// @param Table Actions the samples have to be laid out for
+	virtual void ConsumeSamples(const FSteamInputActionTable& Table, InputHandle_t Controller, TArray<FSteamInputSample>& OutSamples) {}
+
+	/// Time at which the state of an action actually changed, for sources that know it better than the time it was sampled
+	/// @return 0 if unknown
+	virtual double GetChangeTime(InputHandle_t Controller, bool bAnalog, int32 ActionIndex) const {return 0.0;}
+};
+
+/**
+ * ISteamInputSource reading the controllers through SteamInput().
+ * The SteamCore callback pump runs Steam frames too, RunFrame holds FSteamCoreModule::GetRunFrameLock so the two never overlap.
+ */
+class FSteamInputLiveSource : public ISteamInputSource
+{
+public:
+	FSteamInputLiveSource();
+
+	static TSharedRef<ISteamInputSource, ESPMode::ThreadSafe> Get();
+
+	virtual void RunFrame() override;
+	virtual int32 GetConnectedControllers(InputHandle_t* OutControllers) override;
+	virtual void PollSample(const FSteamInputActionTable& Table, InputHandle_t Controller, FSteamInputSample& OutSample) override;
+	virtual void SetPollList(InputHandle_t Controller, const TSharedPtr<const FSteamInputPollList, ESPMode::ThreadSafe>& PollList) override;
+	virtual bool SetActionEventHandler(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& Table, TFunction<void(const FSteamInputActionEvent&)> Handler) override;
+
+private:
+	static void OnSteamActionEvent(struct SteamInputActionEvent_t* Event);
+
+	/** Taken from the SteamCore module on the game thread, RunFrame is also called from the sampler thread */
+	FCriticalSection& RunFrameLock;
+
+	FCriticalSection EventLock;
+	TFunction<void(const FSteamInputActionEvent&)> EventHandler;
+	TMap<uint64, int32> DigitalIndexByHandle;
+	TMap<uint64, int32> AnalogIndexByHandle;
+
+	/** Poll list of every controller with an action set, read by whichever thread polls */
+	FCriticalSection PollListLock;
+	TMap<InputHandle_t, TSharedPtr<const FSteamInputPollList, ESPMode::ThreadSafe>> PollLists;
+};
@@ -0,0 +1,91 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Haptics/SteamInputHapticEnvelope.h"
+
+#include "Curves/CurveFloat.h"
+
+void FSteamInputHapticEnvelope::Evaluate(const float Time, FForceFeedbackValues& OutValues, FVector2f& OutTriggers) const
+{
+	OutValues = FForceFeedbackValues();
+	OutTriggers = FVector2f::ZeroVector;
+
+	if (Values.Num() == 0)
+	{
+		return;
+	}
+
+	const float Position = FMath::Clamp(Time * SampleRate, 0.0f, static_cast<float>(Values.Num() - 1));
+	const int32 Index = FMath::Min(FMath::FloorToInt32(Position), Values.Num() - 2);
+	if (Index < 0)
+	{
+		OutValues = Values[0];
+		OutTriggers = Triggers.Num() > 0 ? Triggers[0] : FVector2f::ZeroVector;
+		return;
+	}
+
+	const float Alpha = Position - Index;
+	const FForceFeedbackValues& From = Values[Index];
+	const FForceFeedbackValues& To = Values[Index + 1];
+	OutValues.LeftLarge = FMath::Lerp(From.LeftLarge, To.LeftLarge, Alpha);
+	OutValues.LeftSmall = FMath::Lerp(From.LeftSmall, To.LeftSmall, Alpha);
+	OutValues.RightLarge = FMath::Lerp(From.RightLarge, To.RightLarge, Alpha);
+	OutValues.RightSmall = FMath::Lerp(From.RightSmall, To.RightSmall, Alpha);
+
+	if (Triggers.Num() == Values.Num())
+	{
+		OutTriggers = FMath::Lerp(Triggers[Index], Triggers[Index + 1], Alpha);
+	}
+}
+
+TSharedRef<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe> FSteamInputHapticEnvelope::Build(const float Duration, const float SampleRate,
+	TFunctionRef<void(float Time, FForceFeedbackValues& OutValues, FVector2f& OutTriggers)> Evaluate)
+{
+	const TSharedRef<FSteamInputHapticEnvelope, ESPMode::ThreadSafe> Envelope = MakeShared<FSteamInputHapticEnvelope, ESPMode::ThreadSafe>();
+	Envelope->SampleRate = FMath::Max(SampleRate, 1.0f);
+
+	const int32 NumSamples = FMath::CeilToInt32(FMath::Max(Duration, 0.0f) * Envelope->SampleRate) + 1;
+	Envelope->Values.SetNumZeroed(NumSamples);
+	Envelope->Triggers.SetNumZeroed(NumSamples);
+
+	bool bHasTriggers = false;
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		Evaluate(Index / Envelope->SampleRate, Envelope->Values[Index], Envelope->Triggers[Index]);
+		bHasTriggers |= !Envelope->Triggers[Index].IsNearlyZero();
+	}
+
+	//most envelopes don't touch the triggers, don't interpolate zeros for them
+	if (!bHasTriggers)
+	{
+		Envelope->Triggers.Empty();
+	}
+
+	return Envelope;
+}
+
+TSharedRef<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe> FSteamInputHapticEnvelope::FromCurves(const UCurveFloat* LargeMotors, const UCurveFloat* SmallMotors,
+	const UCurveFloat* TriggerMotors, const float SampleRate)
+{
+	float Duration = 0.0f;
+	for (const UCurveFloat* Curve : {LargeMotors, SmallMotors, TriggerMotors})
+	{
+		if (Curve)
+		{
+			float MinTime = 0.0f;
+			float MaxTime = 0.0f;
+			Curve->GetTimeRange(MinTime, MaxTime);
+			Duration = FMath::Max(Duration, MaxTime);
+		}
+	}
+
+	return Build(Duration, SampleRate, [LargeMotors, SmallMotors, TriggerMotors](const float Time, FForceFeedbackValues& OutValues, FVector2f& OutTriggers)
+	{
+		const float Large = LargeMotors ? FMath::Clamp(LargeMotors->GetFloatValue(Time), 0.0f, 1.0f) : 0.0f;
+		const float Small = SmallMotors ? FMath::Clamp(SmallMotors->GetFloatValue(Time), 0.0f, 1.0f) : 0.0f;
+		const float Trigger = TriggerMotors ? FMath::Clamp(TriggerMotors->GetFloatValue(Time), 0.0f, 1.0f) : 0.0f;
+
+		OutValues.LeftLarge = OutValues.RightLarge = Large;
+		OutValues.LeftSmall = OutValues.RightSmall = Small;
+		OutTriggers = FVector2f(Trigger, Trigger);
+	});
+}
@@ -0,0 +1,288 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Haptics/SteamInputHapticPlayer.h"
+
+#include "Globals.h"
+#include "Haptics/SteamInputHapticEnvelope.h"
+#include "HAL/Event.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "Profiling/SteamIPCStats.h"
+
+namespace
+{
+	/** Scale a force feedback value onto the motor speed range of ISteamInput::TriggerVibration */
+	uint16 ToMotorSpeed(const float Value)
+	{
+		return static_cast<uint16>(FMath::Clamp(Value, 0.0f, 1.0f) * MAX_uint16);
+	}
+}
+
+FSteamInputHapticCapabilities FSteamInputHapticCapabilities::Get(const ESteamInputType InputType)
+{
+	FSteamInputHapticCapabilities Capabilities;
+	switch (InputType)
+	{
+	case k_ESteamInputType_SteamController:
+	case k_ESteamInputType_SteamDeckController:
+		Capabilities.bSpatialMotors = true;
+		break;
+	case k_ESteamInputType_XBoxOneController:
+		Capabilities.bTriggerRumble = true;
+		break;
+	case k_ESteamInputType_SwitchJoyConPair:
+		//each Joy-Con has its own HD rumble actuator, one per half
+		Capabilities.bSpatialMotors = true;
+		break;
+	case k_ESteamInputType_MobileTouch:
+	case k_ESteamInputType_AppleMFiController:
+		Capabilities.bRumble = false;
+		break;
+	default:
+		break;
+	}
+	return Capabilities;
+}
+
+FSteamInputMotorSpeeds FSteamInputHapticCapabilities::ToMotorSpeeds(const FForceFeedbackValues& Values, const FVector2f& Triggers) const
+{
+	FSteamInputMotorSpeeds Speeds;
+	if (!bRumble)
+	{
+		return Speeds;
+	}
+
+	//Steam drives two motors, fold the four engine channels onto them the way the controller lays them out
+	if (bSpatialMotors)
+	{
+		Speeds.Left = ToMotorSpeed(FMath::Max(Values.LeftLarge, Values.LeftSmall));
+		Speeds.Right = ToMotorSpeed(FMath::Max(Values.RightLarge, Values.RightSmall));
+	}
+	else
+	{
+		Speeds.Left = ToMotorSpeed(FMath::Max(Values.LeftLarge, Values.RightLarge));
+		Speeds.Right = ToMotorSpeed(FMath::Max(Values.LeftSmall, Values.RightSmall));
+	}
+
+	if (bTriggerRumble)
+	{
+		Speeds.LeftTrigger = ToMotorSpeed(Triggers.X);
+		Speeds.RightTrigger = ToMotorSpeed(Triggers.Y);
+	}
+
+	return Speeds;
+}
+
+FSteamInputHapticPlayer::FSteamInputHapticPlayer(const double InPlaybackRate)
+	: PlaybackPeriod(1.0 / FMath::Max(InPlaybackRate, 1.0))
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("SteamInputHaptics"), 0, TPri_AboveNormal);
+}
+
+FSteamInputHapticPlayer::~FSteamInputHapticPlayer()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+}
+
+void FSteamInputHapticPlayer::SetBaseSpeeds(const InputHandle_t Controller, const FSteamInputHapticCapabilities& Capabilities, const FSteamInputMotorSpeeds& Speeds)
+{
+	FPendingSends Sends;
+	FScopeLock ScopeLock(&Lock);
+
+	FChannel& Channel = Channels.FindOrAdd(Controller);
+	Channel.Capabilities = Capabilities;
+	Channel.Base = Speeds;
+
+	//while an envelope plays the haptics thread combines both on its next tick
+	if (!Channel.Envelope.IsValid())
+	{
+		QueueSend(Controller, Channel, Speeds, Sends);
+	}
+
+	FlushSends(ScopeLock, Sends);
+}
+
+void FSteamInputHapticPlayer::Play(const InputHandle_t Controller, const FSteamInputHapticCapabilities& Capabilities,
+	const TSharedRef<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe>& Envelope, const float Strength, const bool bLoop)
+{
+	if (!Capabilities.bRumble)
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		FChannel& Channel = Channels.FindOrAdd(Controller);
+		if (!Channel.Envelope.IsValid())
+		{
+			++NumPlaying;
+		}
+
+		Channel.Capabilities = Capabilities;
+		Channel.Envelope = Envelope;
+		Channel.StartTime = FPlatformTime::Seconds();
+		Channel.Strength = Strength;
+		Channel.bLoop = bLoop;
+	}
+
+	WakeEvent->Trigger();
+}
+
+void FSteamInputHapticPlayer::StopEnvelope(const InputHandle_t Controller)
+{
+	FPendingSends Sends;
+	FScopeLock ScopeLock(&Lock);
+
+	FChannel* Channel = Channels.Find(Controller);
+	if (Channel && Channel->Envelope.IsValid())
+	{
+		Channel->Envelope.Reset();
+		--NumPlaying;
+		QueueSend(Controller, *Channel, Channel->Base, Sends);
+	}
+
+	FlushSends(ScopeLock, Sends);
+}
+
+void FSteamInputHapticPlayer::RemoveController(const InputHandle_t Controller)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FChannel Channel;
+	if (Channels.RemoveAndCopyValue(Controller, Channel) && Channel.Envelope.IsValid())
+	{
+		--NumPlaying;
+	}
+}
+
+uint32 FSteamInputHapticPlayer::Run()
+{
+	double NextTickTime = FPlatformTime::Seconds();
+
+	while (!bStopping)
+	{
+		if (NumPlaying == 0)
+		{
+			WakeEvent->Wait();
+			NextTickTime = FPlatformTime::Seconds();
+			continue;
+		}
+
+		Tick(FPlatformTime::Seconds());
+
+		NextTickTime += PlaybackPeriod;
+		const double Now = FPlatformTime::Seconds();
+
+		//same as the sampler, resync after a stall instead of bursting
+		if (NextTickTime < Now - PlaybackPeriod)
+		{
+			NextTickTime = Now;
+		}
+		else if (NextTickTime > Now)
+		{
+			FPlatformProcess::SleepNoStats(static_cast<float>(NextTickTime - Now));
+		}
+	}
+
+	return 0;
+}
+
+void FSteamInputHapticPlayer::Stop()
+{
+	bStopping = true;
+	WakeEvent->Trigger();
+}
+
+void FSteamInputHapticPlayer::Tick(const double Now)
+{
+	FPendingSends Sends;
+	FScopeLock ScopeLock(&Lock);
+
+	for (TPair<InputHandle_t, FChannel>& Pair : Channels)
+	{
+		FChannel& Channel = Pair.Value;
+		if (!Channel.Envelope.IsValid())
+		{
+			continue;
+		}
+
+		const float Duration = Channel.Envelope->GetDuration();
+		double Time = Now - Channel.StartTime;
+		if (Time > Duration)
+		{
+			if (!Channel.bLoop || Duration <= 0.0f)
+			{
+				Channel.Envelope.Reset();
+				--NumPlaying;
+				QueueSend(Pair.Key, Channel, Channel.Base, Sends);
+				continue;
+			}
+
+			Time = FMath::Fmod(Time, static_cast<double>(Duration));
+			Channel.StartTime = Now - Time;
+		}
+
+		FForceFeedbackValues Values;
+		FVector2f Triggers;
+		Channel.Envelope->Evaluate(static_cast<float>(Time), Values, Triggers);
+
+		Values.LeftLarge *= Channel.Strength;
+		Values.LeftSmall *= Channel.Strength;
+		Values.RightLarge *= Channel.Strength;
+		Values.RightSmall *= Channel.Strength;
+		Triggers *= Channel.Strength;
+
+		QueueSend(Pair.Key, Channel, FSteamInputMotorSpeeds::Max(Channel.Capabilities.ToMotorSpeeds(Values, Triggers), Channel.Base), Sends);
+	}
+
+	FlushSends(ScopeLock, Sends);
+}
+
+void FSteamInputHapticPlayer::QueueSend(const InputHandle_t Controller, FChannel& Channel, const FSteamInputMotorSpeeds& Speeds, FPendingSends& OutSends)
+{
+	if (!Channel.Capabilities.bRumble || Channel.Sent == Speeds)
+	{
+		return;
+	}
+
+	Channel.Sent = Speeds;
+	OutSends.Add({Controller, Speeds});
+}
+
+void FSteamInputHapticPlayer::FlushSends(FScopeLock& ScopeLock, const FPendingSends& Sends)
+{
+	if (Sends.IsEmpty())
+	{
+		ScopeLock.Unlock();
+		return;
+	}
+
+	//the ticket is taken under Lock, so a later decision on the other thread can not overtake this one
+	const uint64 Ticket = NextSendTicket++;
+	ScopeLock.Unlock();
+
+	while (ServingSendTicket.load(std::memory_order_acquire) != Ticket)
+	{
+		FPlatformProcess::Yield();
+	}
+
+	if (ISteamInput* Input = SteamInput())
+	{
+		for (const FPendingSend& Send : Sends)
+		{
+			STEAM_IPC_CALL(Haptics, Input, TriggerVibrationExtended, Send.Controller, Send.Speeds.Left, Send.Speeds.Right, Send.Speeds.LeftTrigger,
+				Send.Speeds.RightTrigger);
+		}
+	}
+
+	ServingSendTicket.store(Ticket + 1, std::memory_order_release);
+}
@@ -0,0 +1,127 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "SteamInputTypes.h"
+#include "GenericPlatform/IInputInterface.h"
+#include "steam/isteaminput.h"
+
+#include <atomic>
+
+struct FSteamInputHapticEnvelope;
+class FRunnableThread;
+
+/** Motor speeds of ISteamInput::TriggerVibrationExtended */
+struct FSteamInputMotorSpeeds
+{
+	uint16 Left = 0;
+	uint16 Right = 0;
+	uint16 LeftTrigger = 0;
+	uint16 RightTrigger = 0;
+
+	bool operator==(const FSteamInputMotorSpeeds& Other) const
+	{
+		return Left == Other.Left && Right == Other.Right && LeftTrigger == Other.LeftTrigger && RightTrigger == Other.RightTrigger;
+	}
+
+	static FSteamInputMotorSpeeds Max(const FSteamInputMotorSpeeds& A, const FSteamInputMotorSpeeds& B)
+	{
+		return {FMath::Max(A.Left, B.Left), FMath::Max(A.Right, B.Right), FMath::Max(A.LeftTrigger, B.LeftTrigger), FMath::Max(A.RightTrigger, B.RightTrigger)};
+	}
+};
+
+/** Force feedback a type of controller can play, channels it lacks are dropped before anything is compared or sent */
+struct FSteamInputHapticCapabilities
+{
+	/** Any motor at all, controllers without one never cost an IPC call */
+	bool bRumble = true;
+	/** The two motors sit in the left and right half of the controller instead of being a large and a small one */
+	bool bSpatialMotors = false;
+	/** Separate motors in the triggers */
+	bool bTriggerRumble = false;
+
+	static FSteamInputHapticCapabilities Get(ESteamInputType InputType);
+
+	/// Fold the engine channels onto the motors of the controller
+	/// @param Triggers Trigger rumble, left in X and right in Y
+	FSteamInputMotorSpeeds ToMotorSpeeds(const FForceFeedbackValues& Values, const FVector2f& Triggers) const;
+};
+
+/**
+ * Sends vibration to the controllers and plays FSteamInputHapticEnvelope on a thread of its own, at a higher rate than the frame rate.
+ * The force feedback requested by the engine is the base of every controller, envelopes play on top of it and the stronger of both wins.
+ * Without a playing envelope the base is sent straight from the game thread and the haptics thread sleeps.
+ */
+class FSteamInputHapticPlayer : public FRunnable
+{
+public:
+	/// @param InPlaybackRate Rate in Hz envelopes are evaluated at
+	explicit FSteamInputHapticPlayer(double InPlaybackRate);
+	virtual ~FSteamInputHapticPlayer() override;
+
+	/// Set the vibration requested by the engine for a controller, sent right away unless an envelope plays on it
+	void SetBaseSpeeds(InputHandle_t Controller, const FSteamInputHapticCapabilities& Capabilities, const FSteamInputMotorSpeeds& Speeds);
+
+	/// Play an envelope on a controller, replacing the one playing on it
+	/// @param Strength Scale applied to the envelope
+	/// @param bLoop Restart the envelope once it ended, until StopEnvelope is called
+	void Play(InputHandle_t Controller, const FSteamInputHapticCapabilities& Capabilities, const TSharedRef<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe>& Envelope,
+		float Strength, bool bLoop);
+	/// Stop the envelope playing on a controller, the base vibration continues
+	void StopEnvelope(InputHandle_t Controller);
+	/// Forget a disconnected controller
+	void RemoveController(InputHandle_t Controller);
+
+	double GetPlaybackRate() const {return 1.0 / PlaybackPeriod;}
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	struct FChannel
+	{
+		FSteamInputHapticCapabilities Capabilities;
+		/** Speeds requested by the engine */
+		FSteamInputMotorSpeeds Base;
+		/** Speeds last sent to the controller */
+		FSteamInputMotorSpeeds Sent;
+
+		TSharedPtr<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe> Envelope;
+		double StartTime = 0.0;
+		float Strength = 1.0f;
+		bool bLoop = false;
+	};
+
+	struct FPendingSend
+	{
+		InputHandle_t Controller = 0;
+		FSteamInputMotorSpeeds Speeds;
+	};
+	using FPendingSends = TArray<FPendingSend, TInlineAllocator<4>>;
+
+	/// Evaluate every playing envelope, called on the haptics thread
+	void Tick(double Now);
+	/// Queue speeds for a controller if they differ from what it plays, called with Lock held
+	void QueueSend(InputHandle_t Controller, FChannel& Channel, const FSteamInputMotorSpeeds& Speeds, FPendingSends& OutSends);
+	/// Release Lock and make the queued IPC calls, in the order the game and haptics thread decided on them
+	void FlushSends(FScopeLock& ScopeLock, const FPendingSends& Sends);
+
+	double PlaybackPeriod;
+
+	/** Guards Channels and NextSendTicket, never held across an IPC call */
+	FCriticalSection Lock;
+	TMap<InputHandle_t, FChannel> Channels;
+	/** Ticket lock ordering the IPC calls, a batch of sends takes its ticket under Lock and waits for its turn after releasing it */
+	uint64 NextSendTicket = 0;
+	std::atomic<uint64> ServingSendTicket{0};
+	/** Amount of channels with an envelope, the thread sleeps on WakeEvent while there are none */
+	std::atomic<int32> NumPlaying{0};
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopping{false};
+};
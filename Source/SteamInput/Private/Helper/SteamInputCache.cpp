@@ -4,6 +4,8 @@
 #include "SteamInputCache.h"
 
 #include "ImageUtils.h"
+#include "Profiling/SteamInputStats.h"
+#include "Profiling/SteamTrace.h"
 #include "Engine/Engine.h"
 #include "Engine/Texture2D.h"
 
@@ -12,15 +14,20 @@ UTexture2D* USteamInputCache::GetGlyphTexture(const FString& Origin)
 	// Check cache first
 	if (UTexture2D** CachedTexture = TextureCache.Find(Origin))
 	{
+		STEAM_INPUT_INC_COUNTER(GlyphCacheHits, 1);
 		return *CachedTexture;
 	}
 	
+	STEAM_INPUT_INC_COUNTER(GlyphCacheMisses, 1);
 	return LoadGlyph(Origin);
 }
 
 void USteamInputCache::ClearCache()
 {
 	TextureCache.Empty();
+
+	ResidentBytes = 0;
+	STEAM_INPUT_SET_MEMORY(GlyphBytes, ResidentBytes);
 }
 
 USteamInputCache* USteamInputCache::Get()
@@ -30,5 +37,14 @@ USteamInputCache* USteamInputCache::Get()
 
 UTexture2D* USteamInputCache::LoadGlyph(const FString& Origin)
 {
-	return TextureCache.Add(Origin, FImageUtils::ImportFileAsTexture2D(Origin));
+	STEAM_TRACE_SCOPE(SteamInput_LoadGlyph);
+	
+	UTexture2D* Texture = FImageUtils::ImportFileAsTexture2D(Origin);
+	if (Texture)
+	{
+		ResidentBytes += Texture->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		STEAM_INPUT_SET_MEMORY(GlyphBytes, ResidentBytes);
+	}
+
+	return TextureCache.Add(Origin, Texture);
 }
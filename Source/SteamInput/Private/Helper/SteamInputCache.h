@@ -24,6 +24,9 @@ public:
 private:
 	UPROPERTY()
 	TMap<FString, UTexture2D*> TextureCache;
+
+	/** Estimated memory of every cached glyph texture */
+	SIZE_T ResidentBytes = 0;
 	
 	// Load texture synchronously
 	UTexture2D* LoadGlyph(const FString& Origin);
@@ -4,7 +4,14 @@
 #include "Helper/SteamInputFunctionLibrary.h"
 
 #include "SteamInputCache.h"
+#include "SteamInput.h"
 #include "Controller/FSteamInputController.h"
+#include "Controller/FSteamInputMotionSampler.h"
+#include "Controller/FSteamInputSampler.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Haptics/SteamInputHapticEnvelope.h"
+#include "Helper/SteamInputQueryCache.h"
+#include "Profiling/SteamIPCStats.h"
 #include "Settings/SteamInputSettings.h"
 #include "Engine/Texture2D.h"
 
@@ -86,7 +93,7 @@ FInputActionSetHandle USteamInputFunctionLibrary::GetActionSetHandle(const FName
 		return *Handle;
 	}
 
-	if (InputActionSetHandle_t Handle = SteamInput()->GetActionSetHandle(TCHAR_TO_UTF8(*Name.ToString())))
+	if (InputActionSetHandle_t Handle = STEAM_IPC_CALL(Input, SteamInput(), GetActionSetHandle, TCHAR_TO_UTF8(*Name.ToString())))
 	{
 		return CachedHandles.Add(Name, Handle);
 	}
@@ -143,18 +150,9 @@ TArray<FSteamInputActionOrigin> USteamInputFunctionLibrary::GetInputActionOrigin
 	}
 	
 	EInputActionOrigin Origins[STEAM_INPUT_MAX_ORIGINS]{};
-	int Count;
-
-	switch (ActionHandle.GetType())
-	{
-	case ActionType::EAnalog:
-		Count = SteamInput()->GetAnalogActionOrigins(Handle, ActionSetHandle, ActionHandle.GetAnalogActionHandle(), Origins);
-		break;
-	case ActionType::EDigital:
-	default:
-		Count = SteamInput()->GetDigitalActionOrigins(Handle, ActionSetHandle, ActionHandle.GetDigitalActionHandle(), Origins);
-		break;
-	}
+	const bool bAnalog = ActionHandle.GetType() == ActionType::EAnalog;
+	const uint64 Action = bAnalog ? ActionHandle.GetAnalogActionHandle() : ActionHandle.GetDigitalActionHandle();
+	const int32 Count = FSteamInputQueryCache::Get().GetActionOrigins(Handle, ActionSetHandle, Action, bAnalog, Origins);
 	
 	TArray<FSteamInputActionOrigin> Out;
 	Out.Reserve(Count);
@@ -173,7 +171,9 @@ UTexture2D* USteamInputFunctionLibrary::GetTextureFromActionOrigin(FSteamInputAc
 		return TextureOverwrite->LoadSynchronous();
 	}
 	
-	return USteamInputCache::Get()->GetGlyphTexture(SteamInput()->GetGlyphPNGForActionOrigin(static_cast<EInputActionOrigin>(ActionOrigin.ActionOrigin), k_ESteamInputGlyphSize_Large, 0));
+	return SteamInput()
+		? USteamInputCache::Get()->GetGlyphTexture(FSteamInputQueryCache::Get().GetGlyphPNGForActionOrigin(static_cast<EInputActionOrigin>(ActionOrigin.ActionOrigin), k_ESteamInputGlyphSize_Large, 0))
+		: nullptr;
 }
 
 FControllerActionHandle USteamInputFunctionLibrary::GetActionHandle(const FName& ActionName)
@@ -205,3 +205,92 @@ FControllerActionHandle USteamInputFunctionLibrary::GetActionHandle(const FName&
 
 	return FControllerActionHandle(Action->CachedHandle, Type);
 }
+
+bool USteamInputFunctionLibrary::GetInputSample(const FInputDeviceId ControllerHandle, const uint64 SampleIndex, FSteamInputSample& OutSample)
+{
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	const FSteamInputSampler* Sampler = Controller.IsValid() ? Controller->GetSampler() : nullptr;
+	if (!Sampler)
+	{
+		return false;
+	}
+
+	return Sampler->ReadSample(GetHandleFromID(ControllerHandle), SampleIndex, OutSample);
+}
+
+uint64 USteamInputFunctionLibrary::GetLatestInputSampleIndex(const FInputDeviceId ControllerHandle)
+{
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	const FSteamInputSampler* Sampler = Controller.IsValid() ? Controller->GetSampler() : nullptr;
+	if (!Sampler)
+	{
+		return 0;
+	}
+
+	return Sampler->GetLatestSampleIndex(GetHandleFromID(ControllerHandle));
+}
+
+TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> USteamInputFunctionLibrary::GetActionTable()
+{
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	return Controller.IsValid() ? Controller->GetActionTable() : nullptr;
+}
+
+const FSteamInputHistory* USteamInputFunctionLibrary::GetInputHistory(const FInputDeviceId ControllerHandle)
+{
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	return Controller.IsValid() ? Controller->FindInputHistory(GetHandleFromID(ControllerHandle)) : nullptr;
+}
+
+const FSteamInputActionEdges* USteamInputFunctionLibrary::GetActionEdges(const FInputDeviceId ControllerHandle)
+{
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	return Controller.IsValid() ? Controller->FindActionEdges(GetHandleFromID(ControllerHandle)) : nullptr;
+}
+
+void USteamInputFunctionLibrary::ReportInputObserved(const FName KeyName, const ESteamInputLatencyPath Path)
+{
+	FSteamInputLatencyTracker::Get().Observe(KeyName, Path);
+}
+
+bool USteamInputFunctionLibrary::GetMotion(const FInputDeviceId ControllerHandle, FSteamInputMotion& OutMotion)
+{
+	const InputHandle_t InputHandle = GetHandleFromID(ControllerHandle);
+	if (InputHandle == 0)
+	{
+		return false;
+	}
+
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	if (const FSteamInputMotion* Motion = Controller.IsValid() ? Controller->FindMotion(InputHandle) : nullptr)
+	{
+		OutMotion = *Motion;
+		return true;
+	}
+
+	OutMotion = FSteamInputMotion();
+	return FSteamInputMotionSampler::ReadMotion(InputHandle, OutMotion);
+}
+
+void USteamInputFunctionLibrary::PlayHapticCurves(const FInputDeviceId ControllerHandle, UCurveFloat* LargeMotors, UCurveFloat* SmallMotors,
+	UCurveFloat* TriggerMotors, const float Strength, const bool bLoop)
+{
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	const InputHandle_t InputHandle = GetHandleFromID(ControllerHandle);
+	if (!Controller.IsValid() || InputHandle == 0 || (!LargeMotors && !SmallMotors && !TriggerMotors))
+	{
+		return;
+	}
+
+	const float SampleRate = GetDefault<USteamInputSettings>()->HapticPlaybackRate;
+	Controller->PlayHapticEnvelope(InputHandle, FSteamInputHapticEnvelope::FromCurves(LargeMotors, SmallMotors, TriggerMotors, SampleRate), Strength, bLoop);
+}
+
+void USteamInputFunctionLibrary::StopHaptics(const FInputDeviceId ControllerHandle)
+{
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	if (Controller.IsValid())
+	{
+		Controller->StopHapticEnvelope(GetHandleFromID(ControllerHandle));
+	}
+}
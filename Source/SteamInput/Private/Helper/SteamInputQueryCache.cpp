@@ -0,0 +1,120 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Helper/SteamInputQueryCache.h"
+
+#include "SteamCore.h"
+#include "Profiling/SteamIPCStats.h"
+#include "Misc/CoreDelegates.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Query Cache Hits"), STAT_SteamInput_QueryCacheHits, STATGROUP_SteamIPC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Query Cache Misses"), STAT_SteamInput_QueryCacheMisses, STATGROUP_SteamIPC);
+
+FSteamInputQueryCache& FSteamInputQueryCache::Get()
+{
+	static FSteamInputQueryCache Cache;
+	return Cache;
+}
+
+void FSteamInputQueryCache::Invalidate()
+{
+	//reset keeps the allocations around for the next frame
+	Origins.Reset();
+	Glyphs.Reset();
+	GamepadControllers.Reset();
+}
+
+void FSteamInputQueryCache::PublishFrameStats()
+{
+	SET_DWORD_STAT(STAT_SteamInput_QueryCacheHits, FrameHits);
+	SET_DWORD_STAT(STAT_SteamInput_QueryCacheMisses, FrameMisses);
+	CSV_CUSTOM_STAT(SteamIPC, QueryCacheHits, static_cast<int32>(FrameHits), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SteamIPC, QueryCacheMisses, static_cast<int32>(FrameMisses), ECsvCustomStatOp::Set);
+	FrameHits = 0;
+	FrameMisses = 0;
+}
+
+void FSteamInputQueryCache::RegisterCallbacks()
+{
+	FSteamCallbackRouter& Router = FSteamCoreModule::Get().GetCallbackRouter();
+
+	CallbackHandles.Add(Router.Register<SteamInputConfigurationLoaded_t>([this](const SteamInputConfigurationLoaded_t&) {Invalidate();}));
+	CallbackHandles.Add(Router.Register<SteamInputDeviceConnected_t>([this](const SteamInputDeviceConnected_t&) {Invalidate();}));
+	CallbackHandles.Add(Router.Register<SteamInputDeviceDisconnected_t>([this](const SteamInputDeviceDisconnected_t&) {Invalidate();}));
+	CallbackHandles.Add(Router.Register<SteamInputGamepadSlotChange_t>([this](const SteamInputGamepadSlotChange_t&) {Invalidate();}));
+
+	//invalidations from callbacks happen any time during the frame, the counts are only published once it ended
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSteamInputQueryCache::PublishFrameStats);
+}
+
+void FSteamInputQueryCache::UnregisterCallbacks()
+{
+	FSteamCallbackRouter& Router = FSteamCoreModule::Get().GetCallbackRouter();
+	for (FSteamCallbackHandle& Handle : CallbackHandles)
+	{
+		Router.Unregister(Handle);
+	}
+	CallbackHandles.Reset();
+
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+}
+
+int32 FSteamInputQueryCache::GetActionOrigins(const InputHandle_t Controller, const InputActionSetHandle_t ActionSet, const uint64 ActionHandle, const bool bAnalog,
+	EInputActionOrigin* OutOrigins)
+{
+	const FOriginsKey Key{Controller, ActionSet, ActionHandle, bAnalog};
+	const TArray<EInputActionOrigin, TInlineAllocator<4>>* Cached = Origins.Find(Key);
+	RecordLookup(Cached != nullptr);
+
+	if (!Cached)
+	{
+		EInputActionOrigin Queried[STEAM_INPUT_MAX_ORIGINS]{};
+		const int32 Count = bAnalog
+			? STEAM_IPC_CALL(Glyphs, SteamInput(), GetAnalogActionOrigins, Controller, ActionSet, ActionHandle, Queried)
+			: STEAM_IPC_CALL(Glyphs, SteamInput(), GetDigitalActionOrigins, Controller, ActionSet, ActionHandle, Queried);
+
+		Cached = &Origins.Add(Key, TArray<EInputActionOrigin, TInlineAllocator<4>>(Queried, FMath::Clamp(Count, 0, STEAM_INPUT_MAX_ORIGINS)));
+	}
+
+	FMemory::Memcpy(OutOrigins, Cached->GetData(), Cached->Num() * sizeof(EInputActionOrigin));
+	return Cached->Num();
+}
+
+const char* FSteamInputQueryCache::GetGlyphPNGForActionOrigin(const EInputActionOrigin Origin, const ESteamInputGlyphSize Size, const uint32 Flags)
+{
+	const uint64 Key = static_cast<uint64>(Origin) | static_cast<uint64>(Size) << 16 | static_cast<uint64>(Flags) << 32;
+	if (const char* const* Cached = Glyphs.Find(Key))
+	{
+		RecordLookup(true);
+		return *Cached;
+	}
+
+	RecordLookup(false);
+	return Glyphs.Add(Key, STEAM_IPC_CALL(Glyphs, SteamInput(), GetGlyphPNGForActionOrigin, Origin, Size, Flags));
+}
+
+InputHandle_t FSteamInputQueryCache::GetControllerForGamepadIndex(const int32 Index)
+{
+	if (const InputHandle_t* Cached = GamepadControllers.Find(Index))
+	{
+		RecordLookup(true);
+		return *Cached;
+	}
+
+	RecordLookup(false);
+	return GamepadControllers.Add(Index, STEAM_IPC_CALL(Haptics, SteamInput(), GetControllerForGamepadIndex, Index));
+}
+
+void FSteamInputQueryCache::RecordLookup(const bool bHit)
+{
+	if (bHit)
+	{
+		++FrameHits;
+		++TotalHits;
+	}
+	else
+	{
+		++FrameMisses;
+		++TotalMisses;
+	}
+}
@@ -0,0 +1,72 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Callbacks/SteamCallbackRouter.h"
+#include "steam/isteaminput.h"
+
+/**
+ * Frame scoped memoization of read only Steam Input queries that prompts, glyphs and vibration ask repeatedly within a frame.
+ * Everything is forgotten at the start of every FSteamInputController::SendControllerEvents and whenever Steam reports a
+ * configuration or device change. Only used from the game thread.
+ */
+class FSteamInputQueryCache
+{
+public:
+	static FSteamInputQueryCache& Get();
+
+	/// Forget every memoized answer
+	void Invalidate();
+	/// Publish the hit and miss counts of the frame that ended and start counting the next one, once per frame from OnEndFrame
+	void PublishFrameStats();
+
+	/// Listen for configuration and device changes through the SteamCore callback router, and for the end of every frame
+	void RegisterCallbacks();
+	void UnregisterCallbacks();
+
+	/// Memoized ISteamInput::GetDigitalActionOrigins / GetAnalogActionOrigins
+	/// @param OutOrigins Receives up to STEAM_INPUT_MAX_ORIGINS origins
+	/// @return Amount of origins written
+	int32 GetActionOrigins(InputHandle_t Controller, InputActionSetHandle_t ActionSet, uint64 ActionHandle, bool bAnalog, EInputActionOrigin* OutOrigins);
+	/// Memoized ISteamInput::GetGlyphPNGForActionOrigin
+	const char* GetGlyphPNGForActionOrigin(EInputActionOrigin Origin, ESteamInputGlyphSize Size, uint32 Flags);
+	/// Memoized ISteamInput::GetControllerForGamepadIndex
+	InputHandle_t GetControllerForGamepadIndex(int32 Index);
+
+	uint64 GetTotalHits() const {return TotalHits;}
+	uint64 GetTotalMisses() const {return TotalMisses;}
+
+private:
+	struct FOriginsKey
+	{
+		InputHandle_t Controller = 0;
+		InputActionSetHandle_t ActionSet = 0;
+		uint64 ActionHandle = 0;
+		bool bAnalog = false;
+
+		bool operator==(const FOriginsKey& Other) const
+		{
+			return Controller == Other.Controller && ActionSet == Other.ActionSet && ActionHandle == Other.ActionHandle && bAnalog == Other.bAnalog;
+		}
+
+		friend uint32 GetTypeHash(const FOriginsKey& Key)
+		{
+			return HashCombineFast(HashCombineFast(GetTypeHash(Key.Controller), GetTypeHash(Key.ActionSet)), GetTypeHash(Key.ActionHandle * 2 + Key.bAnalog));
+		}
+	};
+
+	TMap<FOriginsKey, TArray<EInputActionOrigin, TInlineAllocator<4>>> Origins;
+	TMap<uint64, const char*> Glyphs;
+	TMap<int32, InputHandle_t> GamepadControllers;
+
+	uint32 FrameHits = 0;
+	uint32 FrameMisses = 0;
+	uint64 TotalHits = 0;
+	uint64 TotalMisses = 0;
+
+	TArray<FSteamCallbackHandle> CallbackHandles;
+	FDelegateHandle EndFrameHandle;
+
+	void RecordLookup(bool bHit);
+};
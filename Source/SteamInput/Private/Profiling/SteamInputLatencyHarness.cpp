@@ -0,0 +1,156 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Profiling/SteamInputLatencyHarness.h"
+
+#include "Globals.h"
+#include "SteamInput.h"
+#include "Controller/FSteamInputController.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Controller/SteamInputLatency.h"
+#include "Controller/SteamInputScriptedSource.h"
+#include "Settings/SteamInputSettings.h"
+#include "HAL/IConsoleManager.h"
+
+FSteamInputLatencyHarness::FSteamInputLatencyHarness()
+	: OriginalMode(ESteamInputSamplingMode::PerFrame)
+{
+	Command = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("SteamInput.Latency"),
+		TEXT("Measures input latency against a scripted controller. Start [Action] [IntervalMs], Compare [Seconds] [Action] [IntervalMs], Report, Reset, Stop"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(this, &FSteamInputLatencyHarness::HandleCommand)
+		);
+}
+
+FSteamInputLatencyHarness::~FSteamInputLatencyHarness()
+{
+	Stop();
+
+	if (Command)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(Command);
+		Command = nullptr;
+	}
+}
+
+void FSteamInputLatencyHarness::HandleCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	FSteamInputLatencyTracker& Tracker = FSteamInputLatencyTracker::Get();
+	const FString Verb = Args.Num() > 0 ? Args[0] : TEXT("Report");
+
+	if (Verb == TEXT("Start"))
+	{
+		Start(Args, 1, Ar);
+	}
+	else if (Verb == TEXT("Compare"))
+	{
+		ComparisonSeconds = Args.Num() > 1 ? FMath::Max(FCString::Atod(*Args[1]), 1.0) : 10.0;
+		if (!Start(Args, 2, Ar))
+		{
+			return;
+		}
+
+		OriginalMode = GetDefault<USteamInputSettings>()->SamplingMode;
+		ComparisonModes = {ESteamInputSamplingMode::PerFrame, ESteamInputSamplingMode::FixedRate, ESteamInputSamplingMode::ActionEvents};
+		BeginComparisonMode(ComparisonModes[0]);
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSteamInputLatencyHarness::TickComparison));
+	}
+	else if (Verb == TEXT("Stop"))
+	{
+		Tracker.Report(Ar, TEXT("at stop"));
+		Stop();
+	}
+	else if (Verb == TEXT("Reset"))
+	{
+		Tracker.Reset();
+	}
+	else
+	{
+		Tracker.Report(Ar, StaticEnum<ESteamInputSamplingMode>()->GetNameStringByValue(static_cast<int64>(GetDefault<USteamInputSettings>()->SamplingMode)));
+	}
+}
+
+bool FSteamInputLatencyHarness::Start(const TArray<FString>& Args, const int32 FirstArg, FOutputDevice& Ar)
+{
+	const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController();
+	const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> Table = Controller.IsValid() ? Controller->GetActionTable() : nullptr;
+	if (!Table.IsValid() || Table->DigitalActions.Num() == 0)
+	{
+		Ar.Log(TEXT("SteamInput.Latency needs an active Steam input controller with at least one digital action"));
+		return false;
+	}
+
+	int32 DigitalIndex = 0;
+	if (Args.IsValidIndex(FirstArg))
+	{
+		const FName ActionName(*Args[FirstArg]);
+		DigitalIndex = Table->DigitalActions.IndexOfByPredicate([ActionName](const FSteamInputActionTable::FDigitalAction& Action) {return Action.ActionName == ActionName;});
+		if (DigitalIndex == INDEX_NONE)
+		{
+			Ar.Logf(TEXT("%s is not a digital Steam input action"), *Args[FirstArg]);
+			return false;
+		}
+	}
+
+	const double IntervalMs = Args.IsValidIndex(FirstArg + 1) ? FCString::Atod(*Args[FirstArg + 1]) : 250.0;
+
+	Stop();
+	Controller->SetInputSource(MakeShared<FSteamInputScriptedSource, ESPMode::ThreadSafe>(DigitalIndex, IntervalMs / 1000.0));
+
+	FSteamInputLatencyTracker::Get().Reset();
+	FSteamInputLatencyTracker::Get().SetEnabled(true);
+
+	Ar.Logf(TEXT("Measuring input latency of %s toggled every %.1fms"), *Table->DigitalActions[DigitalIndex].ActionName.ToString(), IntervalMs);
+	return true;
+}
+
+void FSteamInputLatencyHarness::Stop()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+		ComparisonModes.Reset();
+		GetMutableDefault<USteamInputSettings>()->SamplingMode = OriginalMode;
+	}
+
+	FSteamInputLatencyTracker::Get().SetEnabled(false);
+
+	if (const TSharedPtr<FSteamInputController> Controller = FSteamInputModule::Get().GetInputController())
+	{
+		Controller->SetInputSource(nullptr);
+	}
+}
+
+bool FSteamInputLatencyHarness::TickComparison(float DeltaTime)
+{
+	if (FPlatformTime::Seconds() < ModeEndTime || ComparisonModes.Num() == 0)
+	{
+		return true;
+	}
+
+	FSteamInputLatencyTracker::Get().Report(*GLog, StaticEnum<ESteamInputSamplingMode>()->GetNameStringByValue(static_cast<int64>(ComparisonModes[0])));
+	ComparisonModes.RemoveAt(0);
+
+	if (ComparisonModes.Num() == 0)
+	{
+		//returning false removes the ticker
+		TickHandle.Reset();
+		Stop();
+		GetMutableDefault<USteamInputSettings>()->SamplingMode = OriginalMode;
+		return false;
+	}
+
+	BeginComparisonMode(ComparisonModes[0]);
+	return true;
+}
+
+void FSteamInputLatencyHarness::BeginComparisonMode(const ESteamInputSamplingMode Mode)
+{
+	//the controller picks the new mode up on its next frame, stamps taken until then count towards the new mode
+	GetMutableDefault<USteamInputSettings>()->SamplingMode = Mode;
+	FSteamInputLatencyTracker::Get().Reset();
+	ModeEndTime = FPlatformTime::Seconds() + ComparisonSeconds;
+
+	UE_LOG(SteamInputLog, Log, TEXT("Measuring input latency with the %s sampling mode for %.0f seconds"),
+		*StaticEnum<ESteamInputSamplingMode>()->GetNameStringByValue(static_cast<int64>(Mode)), ComparisonSeconds);
+}
@@ -0,0 +1,42 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+enum class ESteamInputSamplingMode : uint8;
+struct IConsoleCommand;
+
+/**
+ * Console driven input latency measurements through FSteamInputLatencyTracker.
+ * Installs an FSteamInputScriptedSource on the input controller so the same scripted presses can be measured with every sampling mode:
+ *   SteamInput.Latency Start [Action] [IntervalMs]   toggle a digital action and start measuring
+ *   SteamInput.Latency Compare [Seconds] [Action] [IntervalMs]   measure PerFrame, FixedRate and ActionEvents one after another
+ *   SteamInput.Latency Report | Reset | Stop
+ */
+class FSteamInputLatencyHarness
+{
+public:
+	FSteamInputLatencyHarness();
+	~FSteamInputLatencyHarness();
+
+private:
+	void HandleCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
+
+	bool Start(const TArray<FString>& Args, int32 FirstArg, FOutputDevice& Ar);
+	void Stop();
+
+	bool TickComparison(float DeltaTime);
+	void BeginComparisonMode(ESteamInputSamplingMode Mode);
+
+	IConsoleCommand* Command = nullptr;
+
+	/** Modes still to be measured by a running comparison, the current one first */
+	TArray<ESteamInputSamplingMode> ComparisonModes;
+	double ComparisonSeconds = 0.0;
+	double ModeEndTime = 0.0;
+	/** Sampling mode configured before the comparison started */
+	ESteamInputSamplingMode OriginalMode;
+	FTSTicker::FDelegateHandle TickHandle;
+};
@@ -0,0 +1,22 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Profiling/SteamInputStats.h"
+
+CSV_DEFINE_CATEGORY(SteamInput, true);
+
+DEFINE_STAT(STAT_SteamInput_Poll);
+DEFINE_STAT(STAT_SteamInput_ConsumeSamples);
+DEFINE_STAT(STAT_SteamInput_ApplyActionSets);
+DEFINE_STAT(STAT_SteamInput_Digital);
+DEFINE_STAT(STAT_SteamInput_Analog);
+DEFINE_STAT(STAT_SteamInput_Filter);
+DEFINE_STAT(STAT_SteamInput_Gestures);
+DEFINE_STAT(STAT_SteamInput_Dispatch);
+
+DEFINE_STAT(STAT_SteamInput_ConnectedControllers);
+DEFINE_STAT(STAT_SteamInput_ActionsPolled);
+DEFINE_STAT(STAT_SteamInput_EventsEmitted);
+DEFINE_STAT(STAT_SteamInput_AnalogEventsSuppressed);
+DEFINE_STAT(STAT_SteamInput_GlyphCacheHits);
+DEFINE_STAT(STAT_SteamInput_GlyphCacheMisses);
+DEFINE_STAT(STAT_SteamInput_GlyphBytes);
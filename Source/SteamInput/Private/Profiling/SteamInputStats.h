@@ -0,0 +1,47 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("Steam Input"), STATGROUP_SteamInput, STATCAT_Advanced);
+CSV_DECLARE_CATEGORY_EXTERN(SteamInput);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Poll"), STAT_SteamInput_Poll, STATGROUP_SteamInput, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Consume Samples"), STAT_SteamInput_ConsumeSamples, STATGROUP_SteamInput, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Action Sets"), STAT_SteamInput_ApplyActionSets, STATGROUP_SteamInput, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Digital Actions"), STAT_SteamInput_Digital, STATGROUP_SteamInput, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Analog Actions"), STAT_SteamInput_Analog, STATGROUP_SteamInput, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Analog Filter"), STAT_SteamInput_Filter, STATGROUP_SteamInput, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gestures"), STAT_SteamInput_Gestures, STATGROUP_SteamInput, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dispatch"), STAT_SteamInput_Dispatch, STATGROUP_SteamInput, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Connected Controllers"), STAT_SteamInput_ConnectedControllers, STATGROUP_SteamInput, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actions Polled"), STAT_SteamInput_ActionsPolled, STATGROUP_SteamInput, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Emitted"), STAT_SteamInput_EventsEmitted, STATGROUP_SteamInput, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Analog Events Suppressed"), STAT_SteamInput_AnalogEventsSuppressed, STATGROUP_SteamInput, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Glyph Cache Hits"), STAT_SteamInput_GlyphCacheHits, STATGROUP_SteamInput, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Glyph Cache Misses"), STAT_SteamInput_GlyphCacheMisses, STATGROUP_SteamInput, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Resident Glyph Memory"), STAT_SteamInput_GlyphBytes, STATGROUP_SteamInput, );
+
+/** Time a scope with the STAT_SteamInput_<Name> cycle counter and the matching SteamInput CSV timing stat */
+#define STEAM_INPUT_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_SteamInput_##Name); \
+	CSV_SCOPED_TIMING_STAT(SteamInput, Name)
+
+/** Add to the per frame STAT_SteamInput_<Name> counter and the matching SteamInput CSV stat, safe to call from any thread */
+#define STEAM_INPUT_INC_COUNTER(Name, Amount) \
+	INC_DWORD_STAT_BY(STAT_SteamInput_##Name, Amount); \
+	CSV_CUSTOM_STAT(SteamInput, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate)
+
+/** Overwrite the STAT_SteamInput_<Name> value and the matching SteamInput CSV stat */
+#define STEAM_INPUT_SET_COUNTER(Name, Value) \
+	SET_DWORD_STAT(STAT_SteamInput_##Name, Value); \
+	CSV_CUSTOM_STAT(SteamInput, Name, static_cast<int32>(Value), ECsvCustomStatOp::Set)
+
+/** Overwrite the STAT_SteamInput_<Name> memory stat, and the matching SteamInput CSV stat in megabytes */
+#define STEAM_INPUT_SET_MEMORY(Name, Bytes) \
+	SET_MEMORY_STAT(STAT_SteamInput_##Name, Bytes); \
+	CSV_CUSTOM_STAT(SteamInput, Name, static_cast<float>(static_cast<double>(Bytes) / (1024.0 * 1024.0)), ECsvCustomStatOp::Set)
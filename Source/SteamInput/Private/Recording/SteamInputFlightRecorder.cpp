@@ -0,0 +1,254 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Recording/SteamInputFlightRecorder.h"
+
+#include "Globals.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Controller/SteamInputFrame.h"
+#include "Recording/SteamInputRecording.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** Ensures within this many seconds of the last dump don't dump again */
+	constexpr double EnsureDumpInterval = 30.0;
+}
+
+FSteamInputFlightRecorder::FSteamInputFlightRecorder()
+{
+	SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddRaw(this, &FSteamInputFlightRecorder::OnSystemError);
+	SystemEnsureHandle = FCoreDelegates::OnHandleSystemEnsure.AddRaw(this, &FSteamInputFlightRecorder::OnSystemEnsure);
+}
+
+FSteamInputFlightRecorder::~FSteamInputFlightRecorder()
+{
+	FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+	FCoreDelegates::OnHandleSystemEnsure.Remove(SystemEnsureHandle);
+}
+
+void FSteamInputFlightRecorder::Update(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& InTable)
+{
+	const USteamInputSettings* Settings = GetDefault<USteamInputSettings>();
+	Seconds = Settings->FlightRecorderSeconds;
+
+	const int32 WantedCapacity = Seconds > 0.0f && InTable.IsValid() ? FMath::Max(Settings->FlightRecorderCapacity, 1) : 0;
+	if (InTable == Table && WantedCapacity == Capacity)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	Table = InTable;
+	Capacity = WantedCapacity;
+	NumWritten = 0;
+
+	if (Capacity == 0)
+	{
+		Arena.Empty();
+		LayoutBytes.Empty();
+		DumpBuffer.Empty();
+		DumpSlots.Empty();
+		EmptyEntry.Empty();
+		Stride = 0;
+		return;
+	}
+
+	NumWords = FMath::DivideAndRoundUp(Table->DigitalActions.Num(), 64);
+	NumAxes = Table->AnalogActions.Num() * 2;
+	Stride = Align(static_cast<int32>(sizeof(FEntryHeader)) + NumWords * static_cast<int32>(sizeof(uint64)) + NumAxes * static_cast<int32>(sizeof(int16)), 16);
+
+	Arena.Empty(Capacity * Stride);
+	Arena.SetNumZeroed(Capacity * Stride);
+	EmptyEntry.Reset();
+	EmptyEntry.SetNumZeroed(Stride);
+
+	LayoutBytes.Reset();
+	FMemoryWriter LayoutWriter(LayoutBytes);
+	SteamInputRecording::SerializeLayout(LayoutWriter, const_cast<FSteamInputActionTable&>(*Table));
+
+	//worst case of every record: type and time, packed integers of up to 5 bytes, zigzag axis deltas of up to 3
+	constexpr int32 RecordHeaderBytes = 6;
+	const int32 SampleBytes = RecordHeaderBytes + 5 + 5 + 5 + NumWords * 8 + FMath::DivideAndRoundUp(NumAxes, 8) + NumAxes * 3;
+	const int32 ConnectBytes = RecordHeaderBytes + 5 + 8;
+	DumpBuffer.Empty(8 + RecordHeaderBytes + LayoutBytes.Num() + Capacity * (RecordHeaderBytes + ConnectBytes + SampleBytes));
+	//reconnected controllers come back with new handles, the ring is the only bound on how many a dump sees
+	DumpSlots.Empty(Capacity);
+
+	CrashFilename = SteamInputRecording::MakeDefaultFilename(TEXT("InputCrash"));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(CrashFilename), true);
+}
+
+void FSteamInputFlightRecorder::RecordSample(const InputHandle_t Controller, const FSteamInputSample& Sample)
+{
+	if (Capacity == 0 || Sample.TableRevision != Table->Revision || Sample.Digital.Words.Num() != NumWords || Sample.Analog.Num() * 2 != NumAxes)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	uint8* Entry = GetEntry(NumWritten);
+
+	FEntryHeader& Header = *reinterpret_cast<FEntryHeader*>(Entry);
+	Header.Timestamp = Sample.Timestamp;
+	Header.Controller = Controller;
+	Header.SampleIndex = Sample.SampleIndex;
+	Header.Frame = FrameNumber;
+
+	FMemory::Memcpy(Entry + sizeof(FEntryHeader), Sample.Digital.Words.GetData(), NumWords * sizeof(uint64));
+
+	int16* Axes = reinterpret_cast<int16*>(Entry + sizeof(FEntryHeader) + NumWords * sizeof(uint64));
+	for (int32 Index = 0; Index < Sample.Analog.Num(); ++Index)
+	{
+		const EKeyType KeyType = Table->AnalogActions[Index].KeyType;
+		Axes[Index * 2] = FSteamInputFrame::QuantizeAxis(Sample.Analog[Index].X, KeyType);
+		Axes[Index * 2 + 1] = FSteamInputFrame::QuantizeAxis(Sample.Analog[Index].Y, KeyType);
+	}
+
+	++NumWritten;
+}
+
+FString FSteamInputFlightRecorder::Dump(const FString& Filename, const TCHAR* Reason)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	double DumpSeconds = 0.0;
+	const int64 NumEntries = EncodeDump(DumpSeconds);
+	if (NumEntries == 0)
+	{
+		return FString();
+	}
+
+	const FString DumpFilename = Filename.IsEmpty() ? SteamInputRecording::MakeDefaultFilename(TEXT("InputFlight")) : Filename;
+	if (!FFileHelper::SaveArrayToFile(DumpBuffer, *DumpFilename))
+	{
+		UE_LOG(SteamInputLog, Error, TEXT("Failed to write input flight recorder to %s"), *DumpFilename);
+		return FString();
+	}
+
+	UE_LOG(SteamInputLog, Log, TEXT("Dumped %lld input samples (%.1f seconds) %s to %s"), NumEntries, DumpSeconds, Reason, *DumpFilename);
+	return DumpFilename;
+}
+
+void FSteamInputFlightRecorder::OnSystemError()
+{
+	//another thread might be stuck holding the lock, a slightly torn dump beats none
+	const bool bLocked = Lock.TryLock();
+
+	double DumpSeconds = 0.0;
+	if (EncodeDump(DumpSeconds) > 0 && !CrashFilename.IsEmpty())
+	{
+		if (IFileHandle* File = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*CrashFilename))
+		{
+			File->Write(DumpBuffer.GetData(), DumpBuffer.Num());
+			delete File;
+		}
+	}
+
+	if (bLocked)
+	{
+		Lock.Unlock();
+	}
+}
+
+void FSteamInputFlightRecorder::OnSystemEnsure()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (LastEnsureDumpTime > 0.0 && Now - LastEnsureDumpTime < EnsureDumpInterval)
+	{
+		return;
+	}
+
+	LastEnsureDumpTime = Now;
+	Dump(FString(), TEXT("on ensure"));
+}
+
+int64 FSteamInputFlightRecorder::EncodeDump(double& OutSeconds)
+{
+	DumpBuffer.Reset();
+	if (Capacity == 0 || NumWritten == 0)
+	{
+		return 0;
+	}
+
+	//only entries within the configured time of the newest one, the ring may hold more at low sample rates
+	const int64 First = FMath::Max<int64>(NumWritten - Capacity, 0);
+	const double NewestTime = reinterpret_cast<const FEntryHeader*>(GetEntry(NumWritten - 1))->Timestamp;
+	int64 Start = First;
+	while (Start < NumWritten - 1 && reinterpret_cast<const FEntryHeader*>(GetEntry(Start))->Timestamp < NewestTime - Seconds)
+	{
+		++Start;
+	}
+
+	FMemoryWriter Ar(DumpBuffer);
+
+	uint32 Magic = SteamInputRecording::Magic;
+	uint32 Version = SteamInputRecording::Version;
+	Ar << Magic << Version;
+
+	double LastTime = reinterpret_cast<const FEntryHeader*>(GetEntry(Start))->Timestamp;
+	SteamInputRecording::WriteRecordHeader(Ar, SteamInputRecording::ERecordType::Layout, 0.0);
+	Ar.Serialize(LayoutBytes.GetData(), LayoutBytes.Num());
+
+	const TConstArrayView<uint64> EmptyWords(reinterpret_cast<const uint64*>(EmptyEntry.GetData() + sizeof(FEntryHeader)), NumWords);
+	const TConstArrayView<int16> EmptyAxes(reinterpret_cast<const int16*>(EmptyEntry.GetData() + sizeof(FEntryHeader) + NumWords * sizeof(uint64)), NumAxes);
+
+	DumpSlots.Reset();
+	uint64 LastFrame = 0;
+
+	for (int64 Index = Start; Index < NumWritten; ++Index)
+	{
+		const uint8* Entry = GetEntry(Index);
+		const FEntryHeader& Header = *reinterpret_cast<const FEntryHeader*>(Entry);
+		const double Delta = Header.Timestamp - LastTime;
+
+		if (Header.Frame != LastFrame)
+		{
+			SteamInputRecording::WriteRecordHeader(Ar, SteamInputRecording::ERecordType::Frame, 0.0);
+			LastFrame = Header.Frame;
+		}
+
+		int32 SlotIndex = DumpSlots.IndexOfByPredicate([&Header](const FDumpSlot& Slot) {return Slot.Controller == Header.Controller;});
+		if (SlotIndex == INDEX_NONE)
+		{
+			SlotIndex = DumpSlots.Num();
+			FDumpSlot& Slot = DumpSlots.AddDefaulted_GetRef();
+			Slot.Controller = Header.Controller;
+
+			uint32 PackedSlot = SlotIndex;
+			SteamInputRecording::WriteRecordHeader(Ar, SteamInputRecording::ERecordType::Connect, 0.0);
+			Ar.SerializeIntPacked(PackedSlot);
+			Ar << Slot.Controller;
+		}
+
+		FDumpSlot& Slot = DumpSlots[SlotIndex];
+
+		//samples are delta encoded straight from the arena, against the previous entry of the same controller
+		const TConstArrayView<uint64> Words(reinterpret_cast<const uint64*>(Entry + sizeof(FEntryHeader)), NumWords);
+		const TConstArrayView<int16> Axes(reinterpret_cast<const int16*>(Entry + sizeof(FEntryHeader) + NumWords * sizeof(uint64)), NumAxes);
+		const TConstArrayView<uint64> BaselineWords = Slot.Entry
+			? TConstArrayView<uint64>(reinterpret_cast<const uint64*>(Slot.Entry + sizeof(FEntryHeader)), NumWords) : EmptyWords;
+		const TConstArrayView<int16> BaselineAxes = Slot.Entry
+			? TConstArrayView<int16>(reinterpret_cast<const int16*>(Slot.Entry + sizeof(FEntryHeader) + NumWords * sizeof(uint64)), NumAxes) : EmptyAxes;
+
+		uint32 PackedSlot = SlotIndex;
+		uint32 IndexDelta = FSteamInputFrame::ZigZagEncode(static_cast<int32>(Header.SampleIndex - Slot.SampleIndex));
+		LastTime += SteamInputRecording::WriteRecordHeader(Ar, SteamInputRecording::ERecordType::Sample, Delta);
+		Ar.SerializeIntPacked(PackedSlot);
+		Ar.SerializeIntPacked(IndexDelta);
+		FSteamInputFrame::SaveDelta(Ar, Words, Axes, BaselineWords, BaselineAxes);
+
+		Slot.SampleIndex = Header.SampleIndex;
+		Slot.Entry = Entry;
+	}
+
+	OutSeconds = NewestTime - reinterpret_cast<const FEntryHeader*>(GetEntry(Start))->Timestamp;
+	return NumWritten - Start;
+}
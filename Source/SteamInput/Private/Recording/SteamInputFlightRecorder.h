@@ -0,0 +1,96 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SteamInputTypes.h"
+
+struct FSteamInputActionTable;
+struct FSteamInputSample;
+
+/**
+ * Always on ring of the last dispatched samples of every controller, dumped as a SteamInputRecording file on demand.
+ * Entries have a fixed stride derived from the action table and live in a single arena that is only reallocated when the layout or the
+ * configured capacity changes, so recording a sample is a handful of copies without touching the heap.
+ * Dumps happen through SteamInput.FlightRecorder, on ensures and on crashes, and can be played back with SteamInput.Replay.
+ * They are encoded into a buffer sized for a full ring up front, so the crash handler neither allocates nor formats anything but opens
+ * a single file it named in advance. Dumps are written next to the recordings of FSteamInputRecorder.
+ */
+class FSteamInputFlightRecorder
+{
+public:
+	FSteamInputFlightRecorder();
+	~FSteamInputFlightRecorder();
+
+	/// Follow the configuration and the current table, reallocating the arena only when either changed
+	void Update(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& InTable);
+	/// Start a new dispatched frame, dumps mark frames so they can be replayed frame locked
+	void RecordFrame() {++FrameNumber;}
+	/// Keep a dispatched sample, must have been taken with the table of the last Update
+	void RecordSample(InputHandle_t Controller, const FSteamInputSample& Sample);
+
+	bool IsEnabled() const {return Capacity > 0;}
+
+	/// Write the last FlightRecorderSeconds into a recording
+	/// @param Filename File to write, empty for a new file next to the recordings
+	/// @param Reason Logged along with the dump
+	/// @return Name of the written file, empty if nothing was written
+	FString Dump(const FString& Filename, const TCHAR* Reason);
+
+private:
+	/** Fixed part of every entry, followed by the digital words and the quantized axes */
+	struct FEntryHeader
+	{
+		double Timestamp;
+		uint64 Controller;
+		uint64 SampleIndex;
+		uint64 Frame;
+	};
+
+	uint8* GetEntry(const int64 Index) {return Arena.GetData() + (Index % Capacity) * Stride;}
+
+	/** Controller seen by a dump, the baseline of its next sample is its last entry */
+	struct FDumpSlot
+	{
+		uint64 Controller = 0;
+		uint64 SampleIndex = 0;
+		/** Last entry of the controller in the arena, null until its first sample */
+		const uint8* Entry = nullptr;
+	};
+
+	void OnSystemError();
+	void OnSystemEnsure();
+	/// Encode the entries within the configured time of the newest one into DumpBuffer, called with the lock held
+	/// @param OutSeconds Time covered by the dump
+	/// @return Amount of entries encoded, 0 if there was nothing to dump
+	int64 EncodeDump(double& OutSeconds);
+
+	TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe> Table;
+	TArray<uint8, TAlignedHeapAllocator<16>> Arena;
+	int32 Stride = 0;
+	int32 NumWords = 0;
+	int32 NumAxes = 0;
+	int32 Capacity = 0;
+	float Seconds = 0.0f;
+
+	/** Encoded layout record payload, the table is not touched by a dump */
+	TArray<uint8> LayoutBytes;
+	/** A dump is encoded here, reserved for a full ring so encoding never allocates */
+	TArray<uint8> DumpBuffer;
+	/** Controllers seen by the dump being encoded, reserved for a ring of entries that all come from different controllers */
+	TArray<FDumpSlot> DumpSlots;
+	/** Zeroed digital words and axes, the baseline of the first sample of every controller */
+	TArray<uint8, TAlignedHeapAllocator<16>> EmptyEntry;
+	/** File a crash dump goes to, named and its directory created whenever the arena is allocated */
+	FString CrashFilename;
+
+	/** Entries written since the arena was allocated, the newest one lives at NumWritten - 1 */
+	int64 NumWritten = 0;
+	uint64 FrameNumber = 0;
+	/** Guards the arena against dumps from other threads, recursive so a crash while recording can still dump */
+	FCriticalSection Lock;
+
+	double LastEnsureDumpTime = 0.0;
+	FDelegateHandle SystemErrorHandle;
+	FDelegateHandle SystemEnsureHandle;
+};
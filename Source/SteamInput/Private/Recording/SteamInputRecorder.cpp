@@ -0,0 +1,350 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Recording/SteamInputRecorder.h"
+
+#include "Globals.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Controller/SteamInputSample.h"
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+#include <atomic>
+
+namespace
+{
+	/** Chunks are handed to the writer once they reach this size */
+	constexpr int32 ChunkSize = 64 * 1024;
+	/** or once they have not been flushed for this long, bounding what a crash can lose */
+	constexpr double FlushInterval = 1.0;
+}
+
+/**
+ * Appends chunks handed over by the recorder to the file on a background thread.
+ */
+class FSteamInputRecordWriter : public FRunnable
+{
+public:
+	explicit FSteamInputRecordWriter(IFileHandle* InFile) : File(InFile)
+	{
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		Thread = FRunnableThread::Create(this, TEXT("SteamInputRecordWriter"), 0, TPri_BelowNormal);
+	}
+
+	virtual ~FSteamInputRecordWriter() override
+	{
+		if (Thread)
+		{
+			Thread->Kill(true);
+			delete Thread;
+			Thread = nullptr;
+		}
+
+		//anything enqueued after the thread saw the stop request
+		WritePending();
+		File.Reset();
+
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+
+	void Enqueue(TArray<uint8>&& Chunk)
+	{
+		Pending.Enqueue(MoveTemp(Chunk));
+		WakeEvent->Trigger();
+	}
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override
+	{
+		while (!bStopping)
+		{
+			WakeEvent->Wait(100);
+			WritePending();
+		}
+
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopping = true;
+		WakeEvent->Trigger();
+	}
+	//~ End FRunnable Interface
+
+private:
+	void WritePending()
+	{
+		TArray<uint8> Chunk;
+		while (Pending.Dequeue(Chunk))
+		{
+			if (File && !File->Write(Chunk.GetData(), Chunk.Num()))
+			{
+				UE_LOG(SteamInputLog, Error, TEXT("Failed to write %d bytes of input recording, stopping to write"), Chunk.Num());
+				File.Reset();
+			}
+		}
+
+		if (File)
+		{
+			File->Flush();
+		}
+	}
+
+	TUniquePtr<IFileHandle> File;
+	TQueue<TArray<uint8>, EQueueMode::Spsc> Pending;
+	FEvent* WakeEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{false};
+};
+
+FSteamInputRecorder::FSteamInputRecorder() = default;
+
+FSteamInputRecorder::~FSteamInputRecorder()
+{
+	Stop();
+}
+
+bool FSteamInputRecorder::Start(const FString& InFilename, const FSteamInputActionTable& Table)
+{
+	Stop();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InFilename));
+
+	IFileHandle* File = PlatformFile.OpenWrite(*InFilename);
+	if (!File)
+	{
+		UE_LOG(SteamInputLog, Error, TEXT("Failed to open %s for input recording"), *InFilename);
+		return false;
+	}
+
+	Writer = MakeUnique<FSteamInputRecordWriter>(File);
+	Filename = InFilename;
+	RecordedBytes = 0;
+	LastRecordTime = FPlatformTime::Seconds();
+	LastFlushTime = LastRecordTime;
+
+	Chunk.Reset(ChunkSize);
+	{
+		FMemoryWriter Ar(Chunk);
+		uint32 Magic = SteamInputRecording::Magic;
+		uint32 Version = SteamInputRecording::Version;
+		Ar << Magic << Version;
+	}
+
+	RecordLayout(Table);
+
+	UE_LOG(SteamInputLog, Log, TEXT("Recording Steam input to %s"), *Filename);
+	return true;
+}
+
+void FSteamInputRecorder::Stop()
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	MaybeFlush(true);
+	Writer.Reset();
+	Slots.Reset();
+
+	UE_LOG(SteamInputLog, Log, TEXT("Recorded %llu bytes of Steam input to %s"), RecordedBytes, *Filename);
+}
+
+void FSteamInputRecorder::RecordFrame()
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	{
+		FMemoryWriter Ar(Chunk);
+		Ar.Seek(Chunk.Num());
+		BeginRecord(Ar, SteamInputRecording::ERecordType::Frame);
+	}
+
+	MaybeFlush(false);
+}
+
+void FSteamInputRecorder::RecordLayout(const FSteamInputActionTable& Table)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	{
+		FMemoryWriter Ar(Chunk);
+		Ar.Seek(Chunk.Num());
+		BeginRecord(Ar, SteamInputRecording::ERecordType::Layout);
+		SteamInputRecording::SerializeLayout(Ar, const_cast<FSteamInputActionTable&>(Table));
+	}
+
+	EmptyFrame.Init(Table);
+	ScratchFrame.Init(Table);
+	for (FSlot& Slot : Slots)
+	{
+		Slot.Frame = EmptyFrame;
+	}
+
+	MaybeFlush(false);
+}
+
+void FSteamInputRecorder::RecordConnection(const InputHandle_t Controller, const bool bConnected)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	if (bConnected)
+	{
+		FindOrAddSlot(Controller);
+		return;
+	}
+
+	const int32 SlotIndex = Slots.IndexOfByPredicate([Controller](const FSlot& Slot) {return Slot.Controller == Controller;});
+	if (SlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	{
+		FMemoryWriter Ar(Chunk);
+		Ar.Seek(Chunk.Num());
+		BeginRecord(Ar, SteamInputRecording::ERecordType::Disconnect);
+		uint32 PackedSlot = SlotIndex;
+		Ar.SerializeIntPacked(PackedSlot);
+	}
+
+	//a reconnecting controller gets a fresh slot, the old one is never referenced again
+	Slots[SlotIndex].Controller = 0;
+	MaybeFlush(false);
+}
+
+void FSteamInputRecorder::RecordActionSets(const InputHandle_t Controller, const uint64 ActionSet, const TConstArrayView<uint64> Layers)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	const int32 SlotIndex = FindOrAddSlot(Controller);
+	FSlot& Slot = Slots[SlotIndex];
+	if (Slot.ActionSet == ActionSet && TConstArrayView<uint64>(Slot.Layers) == Layers)
+	{
+		return;
+	}
+
+	Slot.ActionSet = ActionSet;
+	Slot.Layers = Layers;
+
+	{
+		FMemoryWriter Ar(Chunk);
+		Ar.Seek(Chunk.Num());
+		BeginRecord(Ar, SteamInputRecording::ERecordType::ActionSets);
+
+		uint32 PackedSlot = SlotIndex;
+		Ar.SerializeIntPacked(PackedSlot);
+		Ar << Slot.ActionSet;
+
+		uint32 NumLayers = Slot.Layers.Num();
+		Ar.SerializeIntPacked(NumLayers);
+		for (uint64& Layer : Slot.Layers)
+		{
+			Ar << Layer;
+		}
+	}
+
+	MaybeFlush(false);
+}
+
+void FSteamInputRecorder::RecordSample(const InputHandle_t Controller, const FSteamInputActionTable& Table, const FSteamInputSample& Sample)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	const int32 SlotIndex = FindOrAddSlot(Controller);
+	FSlot& Slot = Slots[SlotIndex];
+
+	ScratchFrame.Quantize(Table, Sample);
+	if (ScratchFrame.Digital.Num() != Slot.Frame.Digital.Num() || ScratchFrame.Axes.Num() != Slot.Frame.Axes.Num())
+	{
+		//sampled with a table that was never recorded as layout
+		return;
+	}
+
+	{
+		FMemoryWriter Ar(Chunk);
+		Ar.Seek(Chunk.Num());
+		BeginRecord(Ar, SteamInputRecording::ERecordType::Sample);
+
+		uint32 PackedSlot = SlotIndex;
+		Ar.SerializeIntPacked(PackedSlot);
+
+		//sample indices only grow, except when the sampling mode changes
+		uint32 IndexDelta = FSteamInputFrame::ZigZagEncode(static_cast<int32>(Sample.SampleIndex - Slot.SampleIndex));
+		Ar.SerializeIntPacked(IndexDelta);
+
+		ScratchFrame.SaveDelta(Ar, Slot.Frame);
+	}
+
+	Slot.SampleIndex = Sample.SampleIndex;
+	Swap(Slot.Frame, ScratchFrame);
+
+	MaybeFlush(false);
+}
+
+int32 FSteamInputRecorder::FindOrAddSlot(const InputHandle_t Controller)
+{
+	const int32 Existing = Slots.IndexOfByPredicate([Controller](const FSlot& Slot) {return Slot.Controller == Controller;});
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+
+	const int32 SlotIndex = Slots.AddDefaulted();
+	Slots[SlotIndex].Controller = Controller;
+	Slots[SlotIndex].Frame = EmptyFrame;
+
+	FMemoryWriter Ar(Chunk);
+	Ar.Seek(Chunk.Num());
+	BeginRecord(Ar, SteamInputRecording::ERecordType::Connect);
+
+	uint32 PackedSlot = SlotIndex;
+	Ar.SerializeIntPacked(PackedSlot);
+	uint64 Handle = Controller;
+	Ar << Handle;
+
+	return SlotIndex;
+}
+
+void FSteamInputRecorder::BeginRecord(FArchive& Ar, const SteamInputRecording::ERecordType Type)
+{
+	//the clock follows what was written, the truncated remainder carries over into the next record
+	LastRecordTime += SteamInputRecording::WriteRecordHeader(Ar, Type, FPlatformTime::Seconds() - LastRecordTime);
+}
+
+void FSteamInputRecorder::MaybeFlush(const bool bForce)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (Chunk.Num() == 0 || (!bForce && Chunk.Num() < ChunkSize && Now - LastFlushTime < FlushInterval))
+	{
+		return;
+	}
+
+	RecordedBytes += Chunk.Num();
+	LastFlushTime = Now;
+
+	Writer->Enqueue(MoveTemp(Chunk));
+	Chunk.Reset(ChunkSize);
+}
@@ -0,0 +1,79 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SteamInputTypes.h"
+#include "Controller/SteamInputFrame.h"
+#include "Recording/SteamInputRecording.h"
+
+struct FSteamInputActionTable;
+struct FSteamInputSample;
+class FSteamInputRecordWriter;
+
+/**
+ * Records everything FSteamInputController dispatches into a SteamInputRecording file.
+ * Records are delta encoded into an in memory chunk on the game thread, full chunks are handed to a background thread that appends them
+ * to the file, so recording only costs the encoding on the frame.
+ */
+class FSteamInputRecorder
+{
+public:
+	FSteamInputRecorder();
+	~FSteamInputRecorder();
+
+	/// Open the file and write the header and layout, stops a running recording first
+	/// @param Filename File to record into, overwritten if it exists
+	/// @param Table Actions the samples will be recorded with
+	/// @return false if the file could not be opened
+	bool Start(const FString& Filename, const FSteamInputActionTable& Table);
+	/// Flush everything recorded so far and close the file
+	void Stop();
+	bool IsRecording() const {return Writer.IsValid();}
+
+	/// Mark the start of a dispatched frame, frame locked replays advance one of these per frame
+	void RecordFrame();
+	/// Record a new action layout, every controller restarts from an empty frame
+	void RecordLayout(const FSteamInputActionTable& Table);
+	void RecordConnection(InputHandle_t Controller, bool bConnected);
+	/// Record the active action set and layers of a controller, only written when they changed
+	void RecordActionSets(InputHandle_t Controller, uint64 ActionSet, TConstArrayView<uint64> Layers);
+	/// Record a dispatched sample, must have been taken with the table of the last layout
+	void RecordSample(InputHandle_t Controller, const FSteamInputActionTable& Table, const FSteamInputSample& Sample);
+
+	/// Size of the recording so far, including what is still waiting to be written
+	uint64 GetRecordedBytes() const {return RecordedBytes + Chunk.Num();}
+	const FString& GetFilename() const {return Filename;}
+
+private:
+	struct FSlot
+	{
+		InputHandle_t Controller = 0;
+		FSteamInputFrame Frame;
+		uint64 SampleIndex = 0;
+		uint64 ActionSet = 0;
+		TArray<uint64, TInlineAllocator<4>> Layers;
+	};
+
+	/// Slot of a controller, assigning and recording a new one if needed
+	int32 FindOrAddSlot(InputHandle_t Controller);
+	/// Start a record, writing its type and the time since the previous record
+	void BeginRecord(FArchive& Ar, SteamInputRecording::ERecordType Type);
+	/// Hand the chunk to the writer once it is full or has not been flushed for a while
+	void MaybeFlush(bool bForce);
+
+	TUniquePtr<FSteamInputRecordWriter> Writer;
+	FString Filename;
+
+	TArray<FSlot> Slots;
+	/** Scratch frame samples get quantized into */
+	FSteamInputFrame ScratchFrame;
+	/** Empty frame of the current layout, the baseline of the first sample of a slot */
+	FSteamInputFrame EmptyFrame;
+
+	TArray<uint8> Chunk;
+	uint64 RecordedBytes = 0;
+	/** Time the written record deltas add up to, trails the clock by less than a microsecond */
+	double LastRecordTime = 0.0;
+	double LastFlushTime = 0.0;
+};
@@ -0,0 +1,65 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Recording/SteamInputRecording.h"
+
+#include "Controller/SteamInputActionTable.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+double SteamInputRecording::WriteRecordHeader(FArchive& Ar, const ERecordType Type, const double Seconds)
+{
+	uint8 TypeByte = static_cast<uint8>(Type);
+	uint32 Microseconds = static_cast<uint32>(FMath::Clamp(Seconds * 1000000.0, 0.0, static_cast<double>(MAX_uint32)));
+	Ar << TypeByte;
+	Ar.SerializeIntPacked(Microseconds);
+	return Microseconds / 1000000.0;
+}
+
+void SteamInputRecording::SerializeLayout(FArchive& Ar, FSteamInputActionTable& Table)
+{
+	//counts come straight from the file when loading, anything above the table limits is corrupt
+	uint32 NumDigital = Table.DigitalActions.Num();
+	Ar.SerializeIntPacked(NumDigital);
+	if (Ar.IsError() || NumDigital > FSteamInputActionTable::MaxDigitalActions)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Table.DigitalActions.SetNum(NumDigital);
+	}
+
+	for (FSteamInputActionTable::FDigitalAction& Action : Table.DigitalActions)
+	{
+		Ar << Action.ActionName;
+	}
+
+	uint32 NumAnalog = Table.AnalogActions.Num();
+	Ar.SerializeIntPacked(NumAnalog);
+	if (Ar.IsError() || NumAnalog > FSteamInputActionTable::MaxAnalogActions)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Table.AnalogActions.SetNum(NumAnalog);
+	}
+
+	for (FSteamInputActionTable::FAnalogAction& Action : Table.AnalogActions)
+	{
+		Ar << Action.ActionName;
+
+		uint8 KeyType = static_cast<uint8>(Action.KeyType);
+		Ar << KeyType;
+		Action.KeyType = static_cast<EKeyType>(KeyType);
+	}
+}
+
+FString SteamInputRecording::MakeDefaultFilename(const TCHAR* Prefix)
+{
+	return FPaths::ProfilingDir() / TEXT("SteamInput") / FString::Printf(TEXT("%s-%s%s"), Prefix, *FDateTime::Now().ToString(), Extension);
+}
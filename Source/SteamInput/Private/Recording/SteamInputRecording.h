@@ -0,0 +1,47 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSteamInputActionTable;
+
+/**
+ * Binary format of Steam input recordings.
+ * A file starts with Magic and Version followed by records until the end of the file. Every record is a type byte, the time since the
+ * previous record in microseconds and its payload. Integers are packed (7 bits per byte) unless noted.
+ *   Frame        no payload, written at the start of every dispatched frame
+ *   Layout       digital count, digital names, analog count, analog names and key types. Resets every controller to an empty frame
+ *   Connect      slot, 64 bit controller handle. Slots are assigned in order of first connection
+ *   Disconnect   slot
+ *   ActionSets   slot, 64 bit action set, layer count, 64 bit layers
+ *   Sample       slot, sample index delta, FSteamInputFrame::SaveDelta against the previous frame of the slot
+ */
+namespace SteamInputRecording
+{
+	static constexpr uint32 Magic = 0x43524953; // "SIRC"
+	static constexpr uint32 Version = 2;
+	static constexpr TCHAR Extension[] = TEXT(".sirec");
+
+	enum class ERecordType : uint8
+	{
+		Frame,
+		Layout,
+		Connect,
+		Disconnect,
+		ActionSets,
+		Sample
+	};
+
+	/// Start a record, writing its type and the time since the previous record
+	/// @param Seconds Time since the previous record, clamped to what fits the format
+	/// @return Seconds as written, whole microseconds. Writers advance their clock by this rather than by Seconds so rounding doesn't add up
+	double WriteRecordHeader(FArchive& Ar, ERecordType Type, double Seconds);
+
+	/// Save the action layout of a table or load it into an empty table, names and key types only
+	void SerializeLayout(FArchive& Ar, FSteamInputActionTable& Table);
+
+	/// Default location of new recordings, inside the profiling directory
+	/// @param Prefix Start of the file name, followed by the current time
+	FString MakeDefaultFilename(const TCHAR* Prefix = TEXT("Input"));
+}
@@ -0,0 +1,376 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#include "Recording/SteamInputReplaySource.h"
+
+#include "Globals.h"
+#include "Recording/SteamInputRecording.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/MemoryReader.h"
+
+TSharedPtr<FSteamInputReplaySource, ESPMode::ThreadSafe> FSteamInputReplaySource::Open(const FString& Filename, const ESteamInputReplayTiming Timing)
+{
+	TSharedRef<FSteamInputReplaySource, ESPMode::ThreadSafe> Source = MakeShared<FSteamInputReplaySource, ESPMode::ThreadSafe>(Timing);
+	if (!Source->MapFile(Filename))
+	{
+		return nullptr;
+	}
+
+	FMemoryReaderView Ar(Source->Data);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic << Version;
+
+	if (Ar.IsError() || Magic != SteamInputRecording::Magic || Version != SteamInputRecording::Version)
+	{
+		UE_LOG(SteamInputLog, Error, TEXT("%s is not a Steam input recording of version %u"), *Filename, SteamInputRecording::Version);
+		return nullptr;
+	}
+
+	Source->ReadOffset = Ar.Tell();
+	UE_LOG(SteamInputLog, Log, TEXT("Replaying Steam input from %s, %lld bytes"), *Filename, static_cast<int64>(Source->Data.Num()));
+	return Source;
+}
+
+bool FSteamInputReplaySource::GetCommandLineReplay(FString& OutFilename, ESteamInputReplayTiming& OutTiming)
+{
+	if (!FParse::Value(FCommandLine::Get(), TEXT("SteamInputReplay="), OutFilename))
+	{
+		return false;
+	}
+
+	FString TimingName;
+	FParse::Value(FCommandLine::Get(), TEXT("SteamInputReplayTiming="), TimingName);
+	OutTiming = TimingName == TEXT("WallClock") ? ESteamInputReplayTiming::WallClock : ESteamInputReplayTiming::FrameLocked;
+	return true;
+}
+
+FSteamInputReplaySource::FSteamInputReplaySource(const ESteamInputReplayTiming InTiming)
+	: Timing(InTiming)
+{
+	bExitWhenFinished = FParse::Param(FCommandLine::Get(), TEXT("SteamInputReplayExit"));
+}
+
+FSteamInputReplaySource::~FSteamInputReplaySource()
+{
+	//the region has to go before the file it maps
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FSteamInputReplaySource::MapFile(const FString& InFilename)
+{
+	Filename = InFilename;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*Filename);
+	if (MappedResult.HasValue())
+	{
+		MappedFile = MappedResult.StealValue();
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		Data = TArrayView<const uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+		return true;
+	}
+
+	MappedFile.Reset();
+	if (FFileHelper::LoadFileToArray(LoadedFile, *Filename, FILEREAD_Silent))
+	{
+		Data = LoadedFile;
+		return true;
+	}
+
+	UE_LOG(SteamInputLog, Error, TEXT("Failed to open input recording %s"), *Filename);
+	return false;
+}
+
+void FSteamInputReplaySource::RunFrame()
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (StartTime == 0.0)
+	{
+		StartTime = Now;
+	}
+
+	//anything not consumed during the previous frame belonged to a controller that was not dispatched, live input would lose it as well
+	for (FSlot& Slot : Slots)
+	{
+		Slot.Pending.Reset();
+	}
+
+	//frame locked replays stop in front of the second frame marker, wall clock replays at the first record that is not due yet
+	const double DueTime = Timing == ESteamInputReplayTiming::WallClock ? Now - StartTime : TNumericLimits<double>::Max();
+	bool bFrameStarted = false;
+	while (ReadRecord(bFrameStarted, DueTime))
+	{
+	}
+
+	if (ReadOffset >= Data.Num())
+	{
+		Finish(TEXT("reached the end of the recording"));
+	}
+}
+
+bool FSteamInputReplaySource::ReadRecord(bool& bInOutFrameStarted, const double DueTime)
+{
+	if (bFinished || ReadOffset >= Data.Num())
+	{
+		return false;
+	}
+
+	FMemoryReaderView Ar(Data);
+	Ar.Seek(ReadOffset);
+
+	uint8 TypeByte = 0;
+	uint32 Microseconds = 0;
+	Ar << TypeByte;
+	Ar.SerializeIntPacked(Microseconds);
+
+	const SteamInputRecording::ERecordType Type = static_cast<SteamInputRecording::ERecordType>(TypeByte);
+	const double Time = RecordTime + Microseconds / 1000000.0;
+
+	if (Type == SteamInputRecording::ERecordType::Frame && bInOutFrameStarted)
+	{
+		return false;
+	}
+
+	if (Time > DueTime)
+	{
+		return false;
+	}
+
+	uint32 SlotIndex = 0;
+	switch (Type)
+	{
+	case SteamInputRecording::ERecordType::Frame:
+		{
+			if (Timing == ESteamInputReplayTiming::FrameLocked)
+			{
+				bInOutFrameStarted = true;
+			}
+			++NumFramesReplayed;
+			break;
+		}
+	case SteamInputRecording::ERecordType::Layout:
+		{
+			Layout = FSteamInputActionTable();
+			SteamInputRecording::SerializeLayout(Ar, Layout);
+			if (Ar.IsError())
+			{
+				break;
+			}
+			EmptyFrame.Init(Layout);
+
+			for (FSlot& Slot : Slots)
+			{
+				Slot.Frame = EmptyFrame;
+				Slot.Pending.Reset();
+			}
+			bRemapDirty = true;
+			break;
+		}
+	case SteamInputRecording::ERecordType::Connect:
+		{
+			uint64 Controller = 0;
+			Ar.SerializeIntPacked(SlotIndex);
+			Ar << Controller;
+
+			if (!Ar.IsError() && SlotIndex <= static_cast<uint32>(Slots.Num()))
+			{
+				FSlot& Slot = SlotIndex == static_cast<uint32>(Slots.Num()) ? Slots.AddDefaulted_GetRef() : Slots[SlotIndex];
+				Slot.Controller = Controller;
+				Slot.bConnected = true;
+				Slot.Frame = EmptyFrame;
+			}
+			else
+			{
+				Ar.SetError();
+			}
+			break;
+		}
+	case SteamInputRecording::ERecordType::Disconnect:
+		{
+			Ar.SerializeIntPacked(SlotIndex);
+			if (Slots.IsValidIndex(SlotIndex))
+			{
+				Slots[SlotIndex].bConnected = false;
+				Slots[SlotIndex].Pending.Reset();
+			}
+			break;
+		}
+	case SteamInputRecording::ERecordType::ActionSets:
+		{
+			//the game activates its own action sets during a replay, they are recorded for inspection only
+			uint64 ActionSet = 0;
+			uint32 NumLayers = 0;
+			Ar.SerializeIntPacked(SlotIndex);
+			Ar << ActionSet;
+			Ar.SerializeIntPacked(NumLayers);
+			for (uint32 Layer = 0; Layer < NumLayers && !Ar.IsError(); ++Layer)
+			{
+				uint64 LayerHandle = 0;
+				Ar << LayerHandle;
+			}
+			break;
+		}
+	case SteamInputRecording::ERecordType::Sample:
+		{
+			uint32 IndexDelta = 0;
+			Ar.SerializeIntPacked(SlotIndex);
+			Ar.SerializeIntPacked(IndexDelta);
+
+			if (!Slots.IsValidIndex(SlotIndex))
+			{
+				Ar.SetError();
+				break;
+			}
+
+			FSlot& Slot = Slots[SlotIndex];
+			FPendingFrame& Pending = Slot.Pending.AddDefaulted_GetRef();
+			Pending.Frame.Init(Layout);
+			Pending.Frame.LoadDelta(Ar, Slot.Frame);
+
+			Slot.SampleIndex += FSteamInputFrame::ZigZagDecode(IndexDelta);
+			Pending.Frame.Tick = Slot.SampleIndex;
+			Pending.Timestamp = StartTime + Time;
+			Slot.Frame = Pending.Frame;
+			break;
+		}
+	default:
+		Ar.SetError();
+		break;
+	}
+
+	if (Ar.IsError() || Ar.Tell() > Data.Num())
+	{
+		Finish(TEXT("found a corrupt record"));
+		return false;
+	}
+
+	ReadOffset = Ar.Tell();
+	RecordTime = Time;
+	return true;
+}
+
+void FSteamInputReplaySource::Finish(const TCHAR* Reason)
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	bFinished = true;
+	for (FSlot& Slot : Slots)
+	{
+		Slot.bConnected = false;
+	}
+
+	UE_LOG(SteamInputLog, Log, TEXT("Replay of %s %s after %lld frames"), *Filename, Reason, NumFramesReplayed);
+
+	if (bExitWhenFinished)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("SteamInputReplay"));
+	}
+}
+
+int32 FSteamInputReplaySource::GetConnectedControllers(InputHandle_t* OutControllers)
+{
+	int32 Count = 0;
+	for (const FSlot& Slot : Slots)
+	{
+		if (Slot.bConnected && Count < STEAM_INPUT_MAX_COUNT)
+		{
+			OutControllers[Count++] = Slot.Controller;
+		}
+	}
+
+	return Count;
+}
+
+void FSteamInputReplaySource::PollSample(const FSteamInputActionTable& Table, const InputHandle_t Controller, FSteamInputSample& OutSample)
+{
+	if (const FSlot* Slot = Slots.FindByPredicate([Controller](const FSlot& Candidate) {return Candidate.bConnected && Candidate.Controller == Controller;}))
+	{
+		ExpandFrame(Table, Slot->Frame, OutSample);
+	}
+}
+
+void FSteamInputReplaySource::ConsumeSamples(const FSteamInputActionTable& Table, const InputHandle_t Controller, TArray<FSteamInputSample>& OutSamples)
+{
+	FSlot* Slot = Slots.FindByPredicate([Controller](const FSlot& Candidate) {return Candidate.bConnected && Candidate.Controller == Controller;});
+	if (!Slot)
+	{
+		return;
+	}
+
+	for (const FPendingFrame& Pending : Slot->Pending)
+	{
+		FSteamInputSample& Sample = OutSamples.AddDefaulted_GetRef();
+		Sample.Init(Table);
+		Sample.SampleIndex = Pending.Frame.Tick;
+		Sample.Timestamp = Pending.Timestamp;
+		ExpandFrame(Table, Pending.Frame, Sample);
+	}
+
+	Slot->Pending.Reset();
+}
+
+void FSteamInputReplaySource::ExpandFrame(const FSteamInputActionTable& Table, const FSteamInputFrame& Frame, FSteamInputSample& OutSample)
+{
+	UpdateRemap(Table);
+
+	if (Frame.Digital.Num() != Layout.DigitalActions.Num() || Frame.Axes.Num() != Layout.AnalogActions.Num() * 2)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < DigitalRemap.Num(); ++Index)
+	{
+		if (DigitalRemap[Index] != INDEX_NONE)
+		{
+			OutSample.Digital.Set(Index, Frame.IsPressed(DigitalRemap[Index]));
+		}
+	}
+
+	for (int32 Index = 0; Index < AnalogRemap.Num(); ++Index)
+	{
+		if (AnalogRemap[Index] != INDEX_NONE)
+		{
+			OutSample.Analog[Index] = Frame.GetAnalog(Layout, AnalogRemap[Index]);
+		}
+	}
+}
+
+void FSteamInputReplaySource::UpdateRemap(const FSteamInputActionTable& Table)
+{
+	if (!bRemapDirty && RemapRevision == Table.Revision && DigitalRemap.Num() == Table.DigitalActions.Num() && AnalogRemap.Num() == Table.AnalogActions.Num())
+	{
+		return;
+	}
+
+	DigitalRemap.Reset(Table.DigitalActions.Num());
+	for (const FSteamInputActionTable::FDigitalAction& Action : Table.DigitalActions)
+	{
+		DigitalRemap.Add(Layout.FindDigitalIndex(Action.ActionName));
+	}
+
+	AnalogRemap.Reset(Table.AnalogActions.Num());
+	for (const FSteamInputActionTable::FAnalogAction& Action : Table.AnalogActions)
+	{
+		AnalogRemap.Add(Layout.FindAnalogIndex(Action.ActionName));
+	}
+
+	RemapRevision = Table.Revision;
+	bRemapDirty = false;
+}
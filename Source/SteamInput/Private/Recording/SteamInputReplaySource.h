@@ -0,0 +1,116 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Controller/SteamInputActionTable.h"
+#include "Controller/SteamInputFrame.h"
+#include "Controller/SteamInputSource.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** How a replay advances through a recording */
+enum class ESteamInputReplayTiming : uint8
+{
+	/** One recorded frame per dispatched frame, independent of the frame rate, for comparable automated runs */
+	FrameLocked,
+	/** Records become due when their recorded time elapsed since the replay started */
+	WallClock
+};
+
+/**
+ * ISteamInputSource playing back a SteamInputRecording file through the regular FSteamInputController dispatch path.
+ * The file is memory mapped and decoded incrementally in RunFrame, recorded actions are matched to the current table by name.
+ * Sample timestamps are the recorded times relative to the start of the replay, so key repeats fire exactly as recorded.
+ * Only used from the game thread, the controller never starts the sampler for sources that provide samples.
+ */
+class FSteamInputReplaySource : public ISteamInputSource
+{
+public:
+	/// Open a recording for replay
+	/// @param Filename Recording written by FSteamInputRecorder
+	/// @param Timing How the replay advances
+	/// @return The source, null if the file could not be opened or is not a recording
+	static TSharedPtr<FSteamInputReplaySource, ESPMode::ThreadSafe> Open(const FString& Filename, ESteamInputReplayTiming Timing);
+
+	/// Replay requested on the command line with -SteamInputReplay=<File> [-SteamInputReplayTiming=WallClock] [-SteamInputReplayExit]
+	/// @return false if no replay was requested
+	static bool GetCommandLineReplay(FString& OutFilename, ESteamInputReplayTiming& OutTiming);
+
+	explicit FSteamInputReplaySource(ESteamInputReplayTiming InTiming);
+	virtual ~FSteamInputReplaySource() override;
+
+	virtual void RunFrame() override;
+	virtual int32 GetConnectedControllers(InputHandle_t* OutControllers) override;
+	virtual void PollSample(const FSteamInputActionTable& Table, InputHandle_t Controller, FSteamInputSample& OutSample) override;
+	virtual bool SetActionEventHandler(const TSharedPtr<const FSteamInputActionTable, ESPMode::ThreadSafe>& Table, TFunction<void(const FSteamInputActionEvent&)> Handler) override {return false;}
+	virtual bool ProvidesSamples() const override {return true;}
+	virtual void ConsumeSamples(const FSteamInputActionTable& Table, InputHandle_t Controller, TArray<FSteamInputSample>& OutSamples) override;
+
+	/** True once every record was replayed or the file turned out to be corrupt */
+	bool IsFinished() const {return bFinished;}
+	/** Amount of recorded frames replayed so far */
+	int64 GetNumFramesReplayed() const {return NumFramesReplayed;}
+	const FString& GetFilename() const {return Filename;}
+
+	/** Request an engine exit once the replay finished, for automated runs */
+	bool bExitWhenFinished = false;
+
+private:
+	struct FPendingFrame
+	{
+		FSteamInputFrame Frame;
+		double Timestamp = 0.0;
+	};
+
+	struct FSlot
+	{
+		InputHandle_t Controller = 0;
+		bool bConnected = false;
+		/** Newest frame of the controller, the baseline of its next sample */
+		FSteamInputFrame Frame;
+		/** Sample index of the newest frame, kept across layout changes like the recorder does */
+		uint64 SampleIndex = 0;
+		/** Frames that became due during the current RunFrame */
+		TArray<FPendingFrame, TInlineAllocator<4>> Pending;
+	};
+
+	bool MapFile(const FString& InFilename);
+	/// Decode and apply the next record, the read offset is left untouched when it is not due yet
+	/// @return false if the record is not due yet, the file ended or the record is corrupt
+	bool ReadRecord(bool& bInOutFrameStarted, double DueTime);
+	void Finish(const TCHAR* Reason);
+
+	/// Lay a recorded frame out for the current table
+	void ExpandFrame(const FSteamInputActionTable& Table, const FSteamInputFrame& Frame, FSteamInputSample& OutSample);
+	void UpdateRemap(const FSteamInputActionTable& Table);
+
+	ESteamInputReplayTiming Timing;
+	FString Filename;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	/** Copy of the file on platforms that can't map it */
+	TArray<uint8> LoadedFile;
+	TArrayView<const uint8> Data;
+	int64 ReadOffset = 0;
+
+	/** Layout of the recording and the slot of every recorded controller */
+	FSteamInputActionTable Layout;
+	FSteamInputFrame EmptyFrame;
+	TArray<FSlot> Slots;
+
+	/** Index of every action of the current table in Layout, INDEX_NONE for actions that were not recorded */
+	TArray<int32> DigitalRemap;
+	TArray<int32> AnalogRemap;
+	uint32 RemapRevision = 0;
+	bool bRemapDirty = true;
+
+	/** Seconds since the start of the recording of the last decoded record */
+	double RecordTime = 0.0;
+	/** FPlatformTime::Seconds() of the first RunFrame, recorded times are offset by it */
+	double StartTime = 0.0;
+	int64 NumFramesReplayed = 0;
+	bool bFinished = false;
+};
@@ -5,12 +5,16 @@
 #include "Globals.h"
 #include "SteamInput.h"
 #include "SteamInputTypes.h"
+#include "Profiling/SteamIPCStats.h"
 #include "Framework/Application/NavigationConfig.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "steam/isteaminput.h"
 #include "steam/isteamutils.h"
 
 const FName USteamInputSettings::MenuCategory = "SteamBindings";
+const FName USteamInputSettings::GyroKeyName = "Steam_Gyro";
 
 bool FSteamInputAction::GenerateHandle()
 {
@@ -25,14 +29,14 @@ bool FSteamInputAction::GenerateHandle()
 	{
 	case EKeyType::Button:
 		{
-			const ControllerDigitalActionHandle_t Handle = SteamInput()->GetDigitalActionHandle(TCHAR_TO_UTF8(*ActionName.ToString()));
+			const ControllerDigitalActionHandle_t Handle = STEAM_IPC_CALL(Input, SteamInput(), GetDigitalActionHandle, TCHAR_TO_UTF8(*ActionName.ToString()));
 			CachedHandle = Handle;
 			bHandleValid = (Handle != 0);
 		}
 		break;
 	default:
 		{
-			const ControllerAnalogActionHandle_t Handle = SteamInput()->GetAnalogActionHandle(TCHAR_TO_UTF8(*ActionName.ToString()));
+			const ControllerAnalogActionHandle_t Handle = STEAM_IPC_CALL(Input, SteamInput(), GetAnalogActionHandle, TCHAR_TO_UTF8(*ActionName.ToString()));
 			CachedHandle = Handle;
 			bHandleValid = (Handle != 0);
 		}
@@ -132,6 +136,27 @@ void USteamInputSettings::RefreshHandles()
 		Key.GenerateKey(true);
 	}
 
+	//the gyro is not an action, its keys exist whatever the action manifest declares
+	const FKey GyroKeyX{GetXAxisName(GyroKeyName)};
+	const FKey GyroKeyY{GetYAxisName(GyroKeyName)};
+	const FKey GyroKey{GyroKeyName};
+	EKeys::AddKey({GyroKeyX, GyroKeyX.GetDisplayName(), FKeyDetails::GamepadKey | FKeyDetails::Axis1D, MenuCategory});
+	EKeys::AddKey({GyroKeyY, GyroKeyY.GetDisplayName(), FKeyDetails::GamepadKey | FKeyDetails::Axis1D, MenuCategory});
+	EKeys::AddPairedKey({GyroKey, GyroKey.GetDisplayName(), FKeyDetails::GamepadKey | FKeyDetails::Axis2D, MenuCategory}, GyroKeyX, GyroKeyY);
+
+	for (const FSteamInputGesture& Gesture : Gestures)
+	{
+		const FKey Key{Gesture.GestureName};
+		if (Gesture.GestureName.IsNone() || EKeys::GetKeyDetails(Key))
+		{
+			UE_LOG(SteamInputLog, Warning, TEXT("Gesture key %s is empty or already exists"), *Gesture.GestureName.ToString());
+			continue;
+		}
+		EKeys::AddKey({Key, Key.GetDisplayName(), FKeyDetails::GamepadKey, MenuCategory});
+	}
+
+	++HandleRevision;
+
 	UpdateSlateNavigationConfig();
 }
 
@@ -256,7 +281,7 @@ void USteamInputSettings::PostLoad()
 void USteamInputSettings::SteamInputInitialized()
 {
 #if WITH_EDITORONLY_DATA
-	AppID = SteamUtils()->GetAppID();
+	AppID = STEAM_IPC_CALL(Core, SteamUtils(), GetAppID);
 #endif
 
 	RefreshHandles();
@@ -272,6 +297,163 @@ void USteamInputSettings::SteamInputInitialized()
 
 #if WITH_EDITOR
 
+namespace
+{
+	/** Entry of a KeyValues file like the action manifest, either a string value or a block of children */
+	struct FManifestNode
+	{
+		FString Key;
+		FString Value;
+		TArray<FManifestNode> Children;
+
+		const FManifestNode* FindChild(const TCHAR* ChildKey) const
+		{
+			return Children.FindByPredicate([ChildKey](const FManifestNode& Child) {return Child.Key.Equals(ChildKey, ESearchCase::IgnoreCase);});
+		}
+	};
+
+	/// Read the next quoted or bare token, braces are tokens of their own
+	/// @return false at the end of the file
+	bool ReadManifestToken(const TCHAR*& Cursor, FString& OutToken, bool& bOutQuoted)
+	{
+		for (;;)
+		{
+			while (FChar::IsWhitespace(*Cursor))
+			{
+				++Cursor;
+			}
+
+			if (Cursor[0] != TEXT('/') || Cursor[1] != TEXT('/'))
+			{
+				break;
+			}
+
+			while (*Cursor && *Cursor != TEXT('\n'))
+			{
+				++Cursor;
+			}
+		}
+
+		if (!*Cursor)
+		{
+			return false;
+		}
+
+		const TCHAR* Start = Cursor;
+		bOutQuoted = *Cursor == TEXT('"');
+		if (bOutQuoted)
+		{
+			Start = ++Cursor;
+			while (*Cursor && *Cursor != TEXT('"'))
+			{
+				Cursor += Cursor[0] == TEXT('\\') && Cursor[1] ? 2 : 1;
+			}
+			OutToken = FString::ConstructFromPtrSize(Start, Cursor - Start);
+			Cursor += *Cursor ? 1 : 0;
+			return true;
+		}
+
+		if (*Cursor == TEXT('{') || *Cursor == TEXT('}'))
+		{
+			++Cursor;
+		}
+		else
+		{
+			while (*Cursor && !FChar::IsWhitespace(*Cursor) && *Cursor != TEXT('{') && *Cursor != TEXT('}') && *Cursor != TEXT('"'))
+			{
+				++Cursor;
+			}
+		}
+		OutToken = FString::ConstructFromPtrSize(Start, Cursor - Start);
+		return true;
+	}
+
+	/// Parse key value pairs up to the closing brace of the current block
+	void ParseManifestBlock(const TCHAR*& Cursor, TArray<FManifestNode>& OutChildren)
+	{
+		FString Token;
+		bool bQuoted = false;
+		while (ReadManifestToken(Cursor, Token, bQuoted))
+		{
+			if (!bQuoted && Token == TEXT("}"))
+			{
+				return;
+			}
+
+			FManifestNode& Node = OutChildren.AddDefaulted_GetRef();
+			Node.Key = MoveTemp(Token);
+			if (!ReadManifestToken(Cursor, Token, bQuoted))
+			{
+				return;
+			}
+
+			if (!bQuoted && Token == TEXT("{"))
+			{
+				ParseManifestBlock(Cursor, Node.Children);
+			}
+			else
+			{
+				Node.Value = MoveTemp(Token);
+			}
+		}
+	}
+}
+
+void USteamInputSettings::ImportActionManifest()
+{
+	const FString Filename = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ActionManifest.FilePath);
+	FString Manifest;
+	if (ActionManifest.FilePath.IsEmpty() || !FFileHelper::LoadFileToString(Manifest, *Filename))
+	{
+		UE_LOG(SteamInputLog, Error, TEXT("Could not read the action manifest %s"), *Filename);
+		return;
+	}
+
+	TArray<FManifestNode> Root;
+	const TCHAR* Cursor = *Manifest;
+	ParseManifestBlock(Cursor, Root);
+
+	//sets and layers list their actions by input kind, the action names are the keys
+	TArray<FSteamInputActionSetActions> Imported;
+	for (const TCHAR* Section : {TEXT("actions"), TEXT("action_layers")})
+	{
+		const FManifestNode* Sets = Root.Num() > 0 ? Root[0].FindChild(Section) : nullptr;
+		if (!Sets)
+		{
+			continue;
+		}
+
+		for (const FManifestNode& Set : Sets->Children)
+		{
+			FSteamInputActionSetActions& Entry = Imported.AddDefaulted_GetRef();
+			Entry.ActionSetName = FName(*Set.Key);
+			for (const TCHAR* Group : {TEXT("StickPadGyro"), TEXT("AnalogTrigger"), TEXT("Button")})
+			{
+				if (const FManifestNode* Actions = Set.FindChild(Group))
+				{
+					for (const FManifestNode& Action : Actions->Children)
+					{
+						Entry.Actions.AddUnique(FName(*Action.Key));
+					}
+				}
+			}
+		}
+	}
+
+	if (Imported.Num() == 0)
+	{
+		UE_LOG(SteamInputLog, Warning, TEXT("Action manifest %s declares no action sets"), *Filename);
+		return;
+	}
+
+	Modify();
+	ActionSets = MoveTemp(Imported);
+	++HandleRevision;
+	TryUpdateDefaultConfigFile();
+
+	UE_LOG(SteamInputLog, Log, TEXT("Imported %d action sets and layers from %s"), ActionSets.Num(), *Filename);
+}
+
 void USteamInputSettings::PostEditChangeChainProperty(struct FPropertyChangedChainEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeChainProperty(PropertyChangedEvent);
@@ -295,6 +477,19 @@ void USteamInputSettings::PostEditChangeChainProperty(struct FPropertyChangedCha
 		bNeedSlateUpdate = true;
 	}
 
+	//filters and action sets are resolved against the action table, rebuild it like for any change to the actions
+	if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(USteamInputSettings, AnalogFilters) ||
+		MemberPropertyName == GET_MEMBER_NAME_CHECKED(USteamInputSettings, ActionSets))
+	{
+		++HandleRevision;
+	}
+
+	//gestures are keys of their own
+	if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(USteamInputSettings, Gestures))
+	{
+		RefreshHandles();
+	}
+
 	// Handle Slate navigation changes
 	if (MemberPropertyName == GET_MEMBER_NAME_CHECKED(USteamInputSettings, SlateNavigationBindings) ||
 		MemberPropertyName == GET_MEMBER_NAME_CHECKED(USteamInputSettings, bAutoConfigureCommonNavigation) ||
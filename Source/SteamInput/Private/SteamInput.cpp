@@ -5,10 +5,14 @@
 #include "Globals.h"
 #include "SteamCore.h"
 #include "Controller/FSteamInputController.h"
+#include "Helper/SteamInputQueryCache.h"
+#include "Profiling/SteamInputLatencyHarness.h"
+#include "Recording/SteamInputReplaySource.h"
 #include "Settings/SettingsInspector.h"
 #include "Settings/SteamInputSettings.h"
 #include "steam/isteaminput.h"
 #include "InputCoreTypes.h"
+#include "HAL/IConsoleManager.h"
 
 #if WITH_EDITOR
 #include "ISettingsModule.h"
@@ -18,6 +22,8 @@
 
 DEFINE_LOG_CATEGORY(SteamInputLog);
 
+FSteamInputModule::~FSteamInputModule() = default;
+
 void FSteamInputModule::StartupModule()
 {
     IInputDeviceModule::StartupModule();
@@ -32,11 +38,37 @@ void FSteamInputModule::StartupModule()
 		    UE_LOG(SteamInputLog, Log, TEXT("Steam Input failed to initialize"));
 	    }
     	bSteamInputInitialized = true;
+
+    	//device callbacks are needed to drop memoized queries when controllers come and go
+    	SteamInput()->EnableDeviceCallbacks();
+    	FSteamInputQueryCache::Get().RegisterCallbacks();
     }
 
 	EKeys::AddMenuCategoryDisplayInfo(GetDefault<USteamInputSettings>()->MenuCategory, LOCTEXT("Steam Keys", "Steam Key Category"), TEXT("GraphEditor.PadEvent_16x"));
 
 	InitializeSlateIntegration();
+
+#if !UE_BUILD_SHIPPING
+	LatencyHarness = MakeUnique<FSteamInputLatencyHarness>();
+#endif
+
+	RecordCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("SteamInput.Record"),
+		TEXT("Records dispatched Steam input to a file. SteamInput.Record [Filename] starts, SteamInput.Record Stop stops"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(this, &FSteamInputModule::HandleRecordCommand)
+		);
+
+	ReplayCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("SteamInput.Replay"),
+		TEXT("Replays a Steam input recording in place of the controllers. SteamInput.Replay Filename [FrameLocked|WallClock] starts, SteamInput.Replay Stop stops"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(this, &FSteamInputModule::HandleReplayCommand)
+		);
+
+	FlightRecorderCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("SteamInput.FlightRecorder"),
+		TEXT("Writes the last seconds of dispatched Steam input to a recording. SteamInput.FlightRecorder [Filename]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(this, &FSteamInputModule::HandleFlightRecorderCommand)
+		);
 	
 #if WITH_EDITOR
     ISettingsModule& SettingsModule = FModuleManager::LoadModuleChecked<ISettingsModule>("Settings");
@@ -76,10 +108,115 @@ void FSteamInputModule::InitializeSlateIntegration() const
 	UE_LOG(SteamInputLog, Log, TEXT("Slate integration initialized"));
 }
 
+void FSteamInputModule::HandleRecordCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) const
+{
+	if (!Controller.IsValid())
+	{
+		Ar.Log(TEXT("SteamInput.Record needs an active Steam input controller"));
+		return;
+	}
+
+	if (Args.Num() > 0 && Args[0] == TEXT("Stop"))
+	{
+		const FSteamInputRecorder& Recorder = Controller->GetRecorder();
+		if (Recorder.IsRecording())
+		{
+			Ar.Logf(TEXT("Stopped recording %s, %llu bytes"), *Recorder.GetFilename(), Recorder.GetRecordedBytes());
+		}
+		Controller->StopRecording();
+		return;
+	}
+
+	if (Controller->StartRecording(Args.Num() > 0 ? Args[0] : FString()))
+	{
+		Ar.Logf(TEXT("Recording Steam input to %s"), *Controller->GetRecorder().GetFilename());
+	}
+	else
+	{
+		Ar.Log(TEXT("Failed to start recording Steam input"));
+	}
+}
+
+void FSteamInputModule::HandleReplayCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) const
+{
+	if (!Controller.IsValid())
+	{
+		Ar.Log(TEXT("SteamInput.Replay needs an active Steam input controller"));
+		return;
+	}
+
+	if (Args.Num() == 0 || Args[0] == TEXT("Stop"))
+	{
+		Controller->SetInputSource(nullptr);
+		return;
+	}
+
+	const ESteamInputReplayTiming Timing = Args.Num() > 1 && Args[1] == TEXT("WallClock") ? ESteamInputReplayTiming::WallClock : ESteamInputReplayTiming::FrameLocked;
+	if (const TSharedPtr<FSteamInputReplaySource, ESPMode::ThreadSafe> Replay = FSteamInputReplaySource::Open(Args[0], Timing))
+	{
+		Controller->SetInputSource(Replay);
+		Ar.Logf(TEXT("Replaying %s"), *Args[0]);
+	}
+	else
+	{
+		Ar.Logf(TEXT("Failed to open %s for replay"), *Args[0]);
+	}
+}
+
+void FSteamInputModule::HandleFlightRecorderCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) const
+{
+	if (!Controller.IsValid())
+	{
+		Ar.Log(TEXT("SteamInput.FlightRecorder needs an active Steam input controller"));
+		return;
+	}
+
+	const FString Filename = Controller->DumpFlightRecorder(Args.Num() > 0 ? Args[0] : FString());
+	if (Filename.IsEmpty())
+	{
+		Ar.Log(TEXT("Nothing to dump, the flight recorder is disabled or has not seen any input yet"));
+	}
+	else
+	{
+		Ar.Logf(TEXT("Dumped the input flight recorder to %s"), *Filename);
+	}
+}
+
 void FSteamInputModule::ShutdownModule()
 {
     IInputDeviceModule::ShutdownModule();
 
+	LatencyHarness.Reset();
+
+	if (RecordCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(RecordCommand);
+		RecordCommand = nullptr;
+	}
+
+	if (ReplayCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ReplayCommand);
+		ReplayCommand = nullptr;
+	}
+
+	if (FlightRecorderCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(FlightRecorderCommand);
+		FlightRecorderCommand = nullptr;
+	}
+
+	if (Controller.IsValid())
+	{
+		Controller->StopRecording();
+	}
+
+	if (bSteamInputInitialized)
+	{
+		FSteamInputQueryCache::Get().UnregisterCallbacks();
+		FSteamInputQueryCache::Get().Invalidate();
+	}
+
     if (SteamInput())
     {
 	    SteamInput()->Shutdown();
@@ -119,11 +256,24 @@ bool FSteamInputModule::BindToOnInputInitialized(const SteamInputInitialized::FD
 TSharedPtr<class IInputDevice> FSteamInputModule::CreateInputDevice(
 	const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler)
 {
-	if (bSteamInputInitialized)
+	//a replay requested on the command line drives the controller even when Steam is not running
+	FString ReplayFilename;
+	ESteamInputReplayTiming ReplayTiming;
+	const bool bReplay = FSteamInputReplaySource::GetCommandLineReplay(ReplayFilename, ReplayTiming);
+
+	if (bSteamInputInitialized || bReplay)
 	{
 		Controller = MakeShared<FSteamInputController>(InMessageHandler);
 	}
 
+	if (bReplay)
+	{
+		if (const TSharedPtr<FSteamInputReplaySource, ESPMode::ThreadSafe> Replay = FSteamInputReplaySource::Open(ReplayFilename, ReplayTiming))
+		{
+			Controller->SetInputSource(Replay);
+		}
+	}
+
 	return Controller;
 }
 
@@ -0,0 +1,96 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SteamInputTypes.h"
+#include "Controller/SteamInputSample.h"
+#include "Settings/SteamInputSettings.h"
+
+/** Actions worth polling for a single combination of action set and layers, as indices into an FSteamInputActionTable */
+struct FSteamInputPollList
+{
+	/** Revision of the table the indices refer to */
+	uint32 TableRevision = 0;
+	TArray<int32> Digital;
+	TArray<int32> Analog;
+};
+
+/**
+ * Flattened view of USteamInputSettings::Keys, splitting the configured actions into a digital and an analog index space.
+ * Samples, bitsets and everything built on top of them address actions by their index in this table instead of by name.
+ */
+struct STEAMINPUT_API FSteamInputActionTable
+{
+	struct FDigitalAction
+	{
+		FName ActionName;
+		ControllerDigitalActionHandle_t Handle = 0;
+	};
+
+	struct FAnalogAction
+	{
+		FName ActionName;
+		/** Names of the generated axis keys, only set for Joystick and MouseInput actions */
+		FName XAxisName;
+		FName YAxisName;
+		ControllerAnalogActionHandle_t Handle = 0;
+		EKeyType KeyType = EKeyType::Analog;
+	};
+
+	/** Digital actions in the order they appear in the settings, actions without a valid handle keep their slot but are never polled */
+	TArray<FDigitalAction> DigitalActions;
+	/** Analog, Joystick and MouseInput actions in the order they appear in the settings */
+	TArray<FAnalogAction> AnalogActions;
+
+	/** Actions of a set or layer of USteamInputSettings::ActionSets */
+	struct FActionSet
+	{
+		FName ActionSetName;
+		InputActionSetHandle_t Handle = 0;
+		FSteamInputActionBits Digital;
+		FSteamInputActionBits Analog;
+	};
+
+	/** Action sets and layers whose handle resolved, actions of sets that did not resolve count as unscoped */
+	TArray<FActionSet> ActionSets;
+	/** Actions not declared by any resolved set, polled whatever set is active */
+	FSteamInputActionBits UnscopedDigital;
+	FSteamInputActionBits UnscopedAnalog;
+
+	/** Most digital actions a table can hold, FSteamInputFrame::SaveDelta tracks changes in a mask of 32 words */
+	static constexpr int32 MaxDigitalActions = 32 * 64;
+	/** Most analog actions a table can hold */
+	static constexpr int32 MaxAnalogActions = 1024;
+
+	/** Handle revision of the settings this table was built from, see USteamInputSettings::GetHandleRevision */
+	uint32 Revision = 0;
+
+	/// Build a table from the current action configuration
+	/// @param Settings Settings to read the actions from
+	/// @return The new table, immutable so it can be shared with the sampling threads
+	static TSharedRef<const FSteamInputActionTable, ESPMode::ThreadSafe> Build(const USteamInputSettings& Settings);
+
+	/// Find the index of a digital action
+	/// @param ActionName Name of the action
+	/// @return Index into DigitalActions, INDEX_NONE if the action is not a configured digital action
+	int32 FindDigitalIndex(FName ActionName) const;
+	/// Find the index of an analog action
+	/// @param ActionName Name of the action
+	/// @return Index into AnalogActions, INDEX_NONE if the action is not a configured analog action
+	int32 FindAnalogIndex(FName ActionName) const;
+
+	/// Build a mask over the digital actions, to test many actions at once against FSteamInputActionBits
+	/// @param ActionNames Digital actions to set, names that are not configured digital actions are ignored
+	/// @return Bitset sized for this table
+	FSteamInputActionBits MakeDigitalMask(TConstArrayView<FName> ActionNames) const;
+
+	/** Whether any action belongs to a resolved set, every action has to be polled otherwise */
+	bool HasActionSets() const {return ActionSets.Num() > 0;}
+
+	/// Collect the actions with a valid handle that can fire for an action set and its layers, including the unscoped ones
+	/// @param ActionSet Active action set
+	/// @param Layers Applied action set layers
+	/// @param OutPollList Receives the action indices
+	void BuildPollList(InputActionSetHandle_t ActionSet, TConstArrayView<InputActionSetHandle_t> Layers, FSteamInputPollList& OutPollList) const;
+};
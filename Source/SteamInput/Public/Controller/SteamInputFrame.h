@@ -0,0 +1,72 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Controller/SteamInputSample.h"
+#include "Settings/SteamInputSettings.h"
+
+struct FSteamInputActionTable;
+
+/**
+ * Compact, quantized version of an FSteamInputSample used for input history and serialization.
+ * Digital actions stay a bitset, every analog component is stored as an int16:
+ * Analog and Joystick actions map -1.0 to 1.0 onto the full int16 range, MouseInput deltas are stored in 1/16th units.
+ */
+struct STEAMINPUT_API FSteamInputFrame
+{
+	/** Sample index the frame was taken at */
+	uint64 Tick = 0;
+
+	/** Pressed state for every digital action */
+	FSteamInputActionBits Digital;
+	/** Quantized analog components, X followed by Y for every analog action */
+	TArray<int16, TInlineAllocator<32>> Axes;
+
+	/// Size the frame for the provided table and clear all state
+	void Init(const FSteamInputActionTable& Table);
+
+	/// Quantize a sample into this frame, the frame must have been initialized with the same table
+	void Quantize(const FSteamInputActionTable& Table, const FSteamInputSample& Sample);
+	/// Expand this frame back into a sample
+	void Dequantize(const FSteamInputActionTable& Table, FSteamInputSample& OutSample) const;
+
+	bool IsPressed(const int32 DigitalIndex) const {return Digital.Get(DigitalIndex);}
+	FVector2f GetAnalog(const FSteamInputActionTable& Table, int32 AnalogIndex) const;
+
+	/// Save this frame as a delta against Baseline, only digital words and axes that differ get written
+	/// @param Ar Saving archive, flagged with an error if the frame does not fit the delta encoding or the baseline layout
+	/// @param Baseline Frame the delta is taken against, an initialized but otherwise empty frame encodes the full state
+	void SaveDelta(FArchive& Ar, const FSteamInputFrame& Baseline) const;
+	/// SaveDelta for state that is not held in frames, such as the flight recorder arena
+	static void SaveDelta(FArchive& Ar, TConstArrayView<uint64> Words, TConstArrayView<int16> Axes, TConstArrayView<uint64> BaselineWords,
+		TConstArrayView<int16> BaselineAxes);
+	/// Load this frame from a delta written by SaveDelta against the same baseline
+	/// @param Ar Loading archive, flagged with an error if the data does not fit the frame layout
+	/// @param Baseline Frame the delta was taken against, initialized with the same table as this frame
+	void LoadDelta(FArchive& Ar, const FSteamInputFrame& Baseline);
+
+	bool operator==(const FSteamInputFrame& Other) const
+	{
+		return Digital == Other.Digital && Axes == Other.Axes;
+	}
+
+	static int16 QuantizeAxis(float Value, EKeyType KeyType);
+	static float DequantizeAxis(int16 Value, EKeyType KeyType);
+
+	/** Map signed values onto unsigned ones so small magnitudes pack into few bytes */
+	static uint32 ZigZagEncode(const int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	static int32 ZigZagDecode(const uint32 Value)
+	{
+		return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+	}
+
+	/** Precision MouseInput deltas are stored with, in steps per unit */
+	static constexpr float MouseInputScale = 16.0f;
+	/** Most digital words a delta can carry, changed words are tracked in a 32 bit mask */
+	static constexpr int32 MaxDeltaWords = 32;
+};
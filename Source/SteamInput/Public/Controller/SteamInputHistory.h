@@ -0,0 +1,55 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Controller/SteamInputFrame.h"
+
+/**
+ * Input history of a single controller for rollback, holding the last Capacity ticks as quantized frames.
+ * Ticks are the sample indices the FSteamInputController dispatched, with the FixedRate sampling mode running at the
+ * simulation rate this gives exactly one frame per simulation tick.
+ */
+class STEAMINPUT_API FSteamInputHistory
+{
+public:
+	/// Allocate the history, this is the only allocation the history makes
+	/// @param Table Action table the frames are laid out with
+	/// @param Capacity Amount of ticks to keep, 0 disables the history
+	void Init(const FSteamInputActionTable& Table, int32 Capacity);
+
+	bool IsEnabled() const {return Frames.Num() > 0;}
+	int32 GetCapacity() const {return Frames.Num();}
+
+	/// Quantize a dispatched sample into the history, using its SampleIndex as tick
+	void Record(const FSteamInputActionTable& Table, const FSteamInputSample& Sample);
+	/// Store an already quantized frame, using its Tick
+	void Store(const FSteamInputFrame& Frame);
+
+	/// Find the frame for a tick in O(1)
+	/// @param Tick Tick to look up
+	/// @return The frame, null if the tick was not recorded or has been overwritten
+	const FSteamInputFrame* Find(uint64 Tick) const;
+	/// Newest recorded frame, null if nothing was recorded yet
+	const FSteamInputFrame* FindLatest() const {return Find(LatestTick);}
+
+	uint64 GetLatestTick() const {return LatestTick;}
+	/// Oldest tick that can still be in the history, frames may be missing for ticks the controller was not sampled in
+	uint64 GetOldestTick() const;
+
+	/// Write the recorded frames in [FirstTick, LastTick], each frame delta encoded against the one before it
+	/// @param Ar Saving archive
+	/// @return Amount of frames written
+	int32 SerializeRange(FArchive& Ar, uint64 FirstTick, uint64 LastTick) const;
+	/// Read frames written by SerializeRange
+	/// @param Ar Loading archive
+	/// @param Table Action table the frames were written with
+	/// @param MaxFrames Most frames the range may hold, usually the capacity of the history it was written from
+	/// @param OutFrames Receives the frames in tick order
+	/// @return false if the data was malformed or held more than MaxFrames frames
+	static bool DeserializeRange(FArchive& Ar, const FSteamInputActionTable& Table, int32 MaxFrames, TArray<FSteamInputFrame>& OutFrames);
+
+private:
+	TArray<FSteamInputFrame> Frames;
+	uint64 LatestTick = 0;
+};
@@ -0,0 +1,100 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SteamInputLatency.generated.h"
+
+/** Point at which an input event is observed for latency measurements */
+UENUM(BlueprintType)
+enum class ESteamInputLatencyPath : uint8
+{
+	/** Handed to the message handler by FSteamInputController */
+	Dispatch,
+	/** Reported from an Enhanced Input action binding */
+	EnhancedInput,
+	/** Reported from game code */
+	GameCode,
+	/** The back buffer of the frame that dispatched the event is about to be presented */
+	Presented,
+	Num UMETA(Hidden)
+};
+
+/**
+ * Fixed resolution latency histogram, 0.25ms buckets up to 256ms with everything slower counted in the last bucket.
+ */
+struct STEAMINPUT_API FSteamInputLatencyHistogram
+{
+	static constexpr double BucketSeconds = 0.00025;
+	static constexpr int32 NumBuckets = 1024;
+
+	void Add(double Seconds);
+	void Reset();
+
+	/// Latency below which the given fraction of the samples fall, with bucket resolution
+	/// @param Percentile 0 to 1
+	double GetPercentile(double Percentile) const;
+	double GetMean() const {return Count > 0 ? TotalSeconds / Count : 0.0;}
+
+	uint64 Count = 0;
+	double TotalSeconds = 0.0;
+	double MaxSeconds = 0.0;
+	uint32 Buckets[NumBuckets] = {};
+};
+
+/**
+ * Measures the time between a controller state change and the points it is observed at.
+ * FSteamInputController stamps every event it hands to the message handler with the index of the sample it came from and the time of
+ * the change, observers then report the key they saw and the newest stamp of that key is attributed to their path once.
+ * Only does work while enabled.
+ */
+class STEAMINPUT_API FSteamInputLatencyTracker
+{
+public:
+	static FSteamInputLatencyTracker& Get();
+
+	void SetEnabled(bool bInEnabled);
+	bool IsEnabled() const {return bEnabled;}
+
+	/// Stamp an event handed to the message handler, records the Dispatch path
+	/// @param Key Key the event was sent for
+	/// @param SampleIndex Sample the event was dispatched from
+	/// @param OriginTime FPlatformTime::Seconds() of the state change, or of the sample when the change time is unknown
+	void Stamp(FName Key, uint64 SampleIndex, double OriginTime);
+
+	/// Report that the newest event of a key reached a path, each stamp is only counted once per path
+	void Observe(FName Key, ESteamInputLatencyPath Path);
+
+	/// Copy of the histogram of a path
+	FSteamInputLatencyHistogram GetHistogram(ESteamInputLatencyPath Path) const;
+	void Reset();
+
+	/// Log the percentiles of every path that has samples
+	/// @param Label Printed in front of the report, for example the sampling mode that was measured
+	void Report(FOutputDevice& Ar, const FString& Label) const;
+
+private:
+	struct FStamp
+	{
+		uint64 SampleIndex = 0;
+		double OriginTime = 0.0;
+		uint64 GameFrame = 0;
+		uint8 ObservedPaths = 0;
+	};
+
+	/** Called on the render thread right before a back buffer is presented */
+	void OnFramePresented();
+	void Record(FStamp& InStamp, ESteamInputLatencyPath Path, double Now);
+
+	bool bEnabled = false;
+	FDelegateHandle PresentHandle;
+
+	/** Newest stamp of every key, so observers only need to know the key */
+	TMap<FName, FStamp> LatestStamps;
+	/** Stamps waiting for the frame that dispatched them to be presented */
+	TArray<FStamp> AwaitingPresent;
+	FSteamInputLatencyHistogram Histograms[static_cast<int32>(ESteamInputLatencyPath::Num)];
+
+	/** Presentation is reported from the render thread */
+	mutable FCriticalSection Mutex;
+};
@@ -0,0 +1,238 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FSteamInputActionTable;
+
+/**
+ * Fixed width bitset over the digital index space of an FSteamInputActionTable.
+ * The first 128 actions are stored inline so copying samples around never touches the heap for common configurations.
+ */
+struct FSteamInputActionBits
+{
+	void Init(const int32 InNumBits)
+	{
+		NumBits = InNumBits;
+		Words.Reset();
+		Words.SetNumZeroed(FMath::DivideAndRoundUp(InNumBits, 64));
+	}
+
+	bool Get(const int32 Index) const
+	{
+		checkSlow(Index >= 0 && Index < NumBits);
+		return (Words[Index >> 6] >> (Index & 63)) & 1;
+	}
+
+	void Set(const int32 Index, const bool bValue)
+	{
+		checkSlow(Index >= 0 && Index < NumBits);
+		const uint64 Mask = 1ull << (Index & 63);
+		if (bValue)
+		{
+			Words[Index >> 6] |= Mask;
+		}
+		else
+		{
+			Words[Index >> 6] &= ~Mask;
+		}
+	}
+
+	void Reset()
+	{
+		FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+	}
+
+	int32 Num() const {return NumBits;}
+
+	/** Whether any bit is set */
+	bool IsAnySet() const
+	{
+		for (const uint64 Word : Words)
+		{
+			if (Word)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	int32 CountSetBits() const
+	{
+		int32 Count = 0;
+		for (const uint64 Word : Words)
+		{
+			Count += FMath::CountBits(Word);
+		}
+		return Count;
+	}
+
+	/** Index of the first set bit, INDEX_NONE if no bit is set */
+	int32 FindFirstSetBit() const
+	{
+		for (int32 Word = 0; Word < Words.Num(); ++Word)
+		{
+			if (Words[Word])
+			{
+				return Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Words[Word]));
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/// Call Func with the index of every set bit in ascending order, skipping 64 clear bits at a time
+	template<typename FuncType>
+	void ForEachSetBit(FuncType&& Func) const
+	{
+		for (int32 Word = 0; Word < Words.Num(); ++Word)
+		{
+			for (uint64 Bits = Words[Word]; Bits; Bits &= Bits - 1)
+			{
+				Func(Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits)));
+			}
+		}
+	}
+
+	/** Whether any bit of Mask is set, both bitsets have to cover the same actions */
+	bool HasAny(const FSteamInputActionBits& Mask) const
+	{
+		checkSlow(NumBits == Mask.NumBits);
+		for (int32 Word = 0; Word < Words.Num(); ++Word)
+		{
+			if (Words[Word] & Mask.Words[Word])
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Whether every bit of Mask is set, both bitsets have to cover the same actions */
+	bool HasAll(const FSteamInputActionBits& Mask) const
+	{
+		checkSlow(NumBits == Mask.NumBits);
+		for (int32 Word = 0; Word < Words.Num(); ++Word)
+		{
+			if ((Words[Word] & Mask.Words[Word]) != Mask.Words[Word])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FSteamInputActionBits& operator&=(const FSteamInputActionBits& Other)
+	{
+		checkSlow(NumBits == Other.NumBits);
+		for (int32 Word = 0; Word < Words.Num(); ++Word)
+		{
+			Words[Word] &= Other.Words[Word];
+		}
+		return *this;
+	}
+
+	FSteamInputActionBits& operator|=(const FSteamInputActionBits& Other)
+	{
+		checkSlow(NumBits == Other.NumBits);
+		for (int32 Word = 0; Word < Words.Num(); ++Word)
+		{
+			Words[Word] |= Other.Words[Word];
+		}
+		return *this;
+	}
+
+	/** Clear every bit that is set in Other */
+	FSteamInputActionBits& RemoveBits(const FSteamInputActionBits& Other)
+	{
+		checkSlow(NumBits == Other.NumBits);
+		for (int32 Word = 0; Word < Words.Num(); ++Word)
+		{
+			Words[Word] &= ~Other.Words[Word];
+		}
+		return *this;
+	}
+
+	bool operator==(const FSteamInputActionBits& Other) const
+	{
+		return NumBits == Other.NumBits && Words == Other.Words;
+	}
+
+	bool operator!=(const FSteamInputActionBits& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	TArray<uint64, TInlineAllocator<2>> Words;
+	int32 NumBits = 0;
+};
+
+/**
+ * State of every configured action on a single controller at a single point in time.
+ * Digital actions are stored as a bitset and analog actions as a 2D value, both indexed through the FSteamInputActionTable the sample was taken with.
+ */
+struct FSteamInputSample
+{
+	/** Monotonic index of the sample, shared between all controllers sampled at the same time. 0 means the sample was never written */
+	uint64 SampleIndex = 0;
+	/** FPlatformTime::Seconds() at which the sample was taken */
+	double Timestamp = 0.0;
+	/** Revision of the action table this sample was taken with */
+	uint32 TableRevision = 0;
+
+	/** Pressed state for every digital action */
+	FSteamInputActionBits Digital;
+	/** Value for every analog action, Analog actions only use X */
+	TArray<FVector2f, TInlineAllocator<16>> Analog;
+
+	/// Size the sample for the provided table and clear all state
+	STEAMINPUT_API void Init(const FSteamInputActionTable& Table);
+};
+
+/**
+ * Digital actions of a single controller over a whole frame, so game code can test many actions at once with bitwise operations
+ * instead of collecting individual button events. Every sample dispatched during the frame contributes its edges, a press and
+ * release between two frames shows up in both Pressed and Released.
+ */
+struct FSteamInputActionEdges
+{
+	/** GFrameCounter of the frame the edges were collected in */
+	uint64 FrameCounter = 0;
+	/** Revision of the action table the bits are indexed with */
+	uint32 TableRevision = 0;
+
+	/** Actions held as of the last sample of the frame */
+	FSteamInputActionBits Down;
+	/** Actions that went down during the frame */
+	FSteamInputActionBits Pressed;
+	/** Actions that went up during the frame */
+	FSteamInputActionBits Released;
+
+	/// Size the bitsets for the provided table and clear them
+	STEAMINPUT_API void Init(const FSteamInputActionTable& Table);
+
+	/// Start collecting a new frame, Down carries over
+	void BeginFrame(const uint64 InFrameCounter)
+	{
+		FrameCounter = InFrameCounter;
+		Pressed.Reset();
+		Released.Reset();
+	}
+
+	/// Add the edges between two consecutive samples of the frame
+	void Accumulate(const FSteamInputActionBits& Previous, const FSteamInputActionBits& Current)
+	{
+		checkSlow(Previous.Num() == Down.Num() && Current.Num() == Down.Num());
+		for (int32 Word = 0; Word < Down.Words.Num(); ++Word)
+		{
+			Pressed.Words[Word] |= Current.Words[Word] & ~Previous.Words[Word];
+			Released.Words[Word] |= Previous.Words[Word] & ~Current.Words[Word];
+			Down.Words[Word] = Current.Words[Word];
+		}
+	}
+
+	bool IsDown(const int32 ActionIndex) const {return Down.Get(ActionIndex);}
+	bool WasPressed(const int32 ActionIndex) const {return Pressed.Get(ActionIndex);}
+	bool WasReleased(const int32 ActionIndex) const {return Released.Get(ActionIndex);}
+};
@@ -0,0 +1,93 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Controller/SteamInputFrame.h"
+#include "Controller/SteamInputHistory.h"
+#include "SteamInputSnapshot.generated.h"
+
+class UPackageMap;
+
+/**
+ * Input of a single controller for a single tick, bit packed for replication.
+ * The layout is generated from the actions configured in USteamInputSettings, both ends of the connection must share the same configuration.
+ * Buttons are sent as bits, analog and joystick axes at SnapshotAxisPrecision bits, and only state that differs from the acknowledged baseline is written.
+ * Use FSteamInputSnapshotBuffer to pick baselines on the sending side and to resolve them on the receiving side.
+ */
+USTRUCT(BlueprintType)
+struct STEAMINPUT_API FSteamInputSnapshot
+{
+	GENERATED_BODY()
+
+	/** Tick the snapshot was taken at */
+	uint64 Tick = 0;
+	/** Tick of the acknowledged snapshot this one is delta compressed against, 0 for a full snapshot */
+	uint64 BaselineTick = 0;
+
+	/** Input state, axes reduced to the configured precision. Only valid on the receiving side once the baseline is resolved */
+	FSteamInputFrame Frame;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/// Whether a received snapshot still has to be resolved against its baseline before Frame can be used
+	bool NeedsBaseline() const {return bPendingBaseline;}
+	/// Apply the baseline to a received delta snapshot
+	/// @param InBaseline Frame of BaselineTick as received earlier
+	/// @return false if the baseline does not match the layout of the snapshot
+	bool ResolveBaseline(const FSteamInputFrame& InBaseline);
+
+	/// Action table describing the snapshot layout, rebuilt from the settings when the actions change
+	static TSharedRef<const FSteamInputActionTable, ESPMode::ThreadSafe> GetLayout();
+	/// Reduce a quantized axis to the precision it will have after replication
+	static int16 ReduceAxis(int16 Value, int32 Precision);
+
+private:
+	/** Frame of BaselineTick, only used when sending */
+	FSteamInputFrame Baseline;
+	/** Axes written in the last received snapshot, every other axis is taken from the baseline */
+	FSteamInputActionBits ReceivedAxes;
+	bool bPendingBaseline = false;
+
+	friend class FSteamInputSnapshotBuffer;
+};
+
+template<>
+struct TStructOpsTypeTraits<FSteamInputSnapshot> : TStructOpsTypeTraitsBase2<FSteamInputSnapshot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Snapshots sent to or received from one connection for one controller.
+ * The sender builds every snapshot against the newest tick the receiver acknowledged, how acknowledgements travel back is up to the game.
+ */
+class STEAMINPUT_API FSteamInputSnapshotBuffer
+{
+public:
+	/// @param Capacity Amount of snapshots to keep, acknowledgements older than this fall back to full snapshots
+	void Init(int32 Capacity);
+
+	/// Build the snapshot to send for a frame, delta compressed against the last acknowledged tick when it is still buffered
+	/// @param InFrame Frame to send, for example taken from FSteamInputHistory
+	/// @return The snapshot, ready to be passed to an RPC or replicated property
+	FSteamInputSnapshot MakeSnapshot(const FSteamInputFrame& InFrame);
+	/// Mark a tick as received by the other end, following snapshots use it as baseline
+	void Acknowledge(uint64 Tick);
+
+	/// Resolve and store a received snapshot
+	/// @param Snapshot Snapshot as deserialized, Frame holds the full state afterwards
+	/// @return false if the baseline is no longer buffered, the snapshot has to be dropped
+	bool Receive(FSteamInputSnapshot& Snapshot);
+
+	/// Sending side: newest tick the receiver acknowledged. Receiving side: newest tick received, to be reported back to the sender
+	uint64 GetAcknowledgedTick() const {return AcknowledgedTick;}
+	const FSteamInputFrame* Find(const uint64 Tick) const {return Frames.Find(Tick);}
+
+private:
+	FSteamInputHistory Frames;
+	uint64 AcknowledgedTick = 0;
+};
@@ -0,0 +1,41 @@
+﻿// Copyright 2026 Cynic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/IInputInterface.h"
+
+class UCurveFloat;
+
+/**
+ * Force feedback curve sampled at a fixed rate, so the haptics thread can play it back without touching any UObject.
+ * Values are the engine force feedback channels, they get folded onto the motors of each controller type during playback.
+ */
+struct STEAMINPUT_API FSteamInputHapticEnvelope
+{
+	/** Samples per second */
+	float SampleRate = 250.0f;
+	/** Channel strengths from 0.0 to 1.0 per sample */
+	TArray<FForceFeedbackValues> Values;
+	/** Trigger rumble per sample, left in X and right in Y. Empty if the envelope has no trigger rumble */
+	TArray<FVector2f> Triggers;
+
+	float GetDuration() const {return Values.Num() > 0 ? (Values.Num() - 1) / SampleRate : 0.0f;}
+
+	/// Interpolate the envelope at a point in time, clamped to its duration
+	void Evaluate(float Time, FForceFeedbackValues& OutValues, FVector2f& OutTriggers) const;
+
+	/// Sample any function into an envelope
+	/// @param Duration Length of the envelope in seconds
+	/// @param SampleRate Samples per second, best matched to USteamInputSettings::HapticPlaybackRate
+	/// @param Evaluate Called once per sample with the time of the sample
+	static TSharedRef<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe> Build(float Duration, float SampleRate,
+		TFunctionRef<void(float Time, FForceFeedbackValues& OutValues, FVector2f& OutTriggers)> Evaluate);
+
+	/// Sample curves into an envelope, the envelope lasts as long as the longest curve
+	/// @param LargeMotors Drives both large channels, may be null
+	/// @param SmallMotors Drives both small channels, may be null
+	/// @param TriggerMotors Drives both trigger motors, may be null
+	static TSharedRef<const FSteamInputHapticEnvelope, ESPMode::ThreadSafe> FromCurves(const UCurveFloat* LargeMotors, const UCurveFloat* SmallMotors,
+		const UCurveFloat* TriggerMotors, float SampleRate);
+};
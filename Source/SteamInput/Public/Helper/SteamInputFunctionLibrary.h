@@ -4,10 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "SteamInputTypes.h"
+#include "Controller/SteamInputLatency.h"
+#include "Controller/SteamInputSample.h"
 #include "GenericPlatform/GenericInputDeviceMap.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "SteamInputFunctionLibrary.generated.h"
 
+class UCurveFloat;
+
 /**
  * 
  */
@@ -106,6 +110,57 @@ public:
 	/// @return The handle for the action, if the action doesn't exist will return an empty handle
 	UFUNCTION(BlueprintCallable, Category = "Steam|Input|Action")
 	static FControllerActionHandle GetActionHandle(const FName& ActionName);
+
+	/// Read a sample taken by the fixed rate sampler, only available while the sampling mode is set to FixedRate
+	/// @param ControllerHandle The controller to read the sample from
+	/// @param SampleIndex Index of the sample, any of the last SampleBufferSize samples can be read
+	/// @param OutSample Receives the sample, actions are indexed through the FSteamInputActionTable returned by GetActionTable
+	/// @return false if the sample is not available
+	static bool GetInputSample(FInputDeviceId ControllerHandle, uint64 SampleIndex, FSteamInputSample& OutSample);
+	/// Get the index of the newest sample taken for the controller by the fixed rate sampler
+	/// @param ControllerHandle The controller to get the sample index for
+	/// @return The newest sample index, 0 if no sample is available
+	static uint64 GetLatestInputSampleIndex(FInputDeviceId ControllerHandle);
+	/// Get the table mapping sample indices to actions
+	/// @return The action table in use by the controller, null if Steam Input is not running
+	static TSharedPtr<const struct FSteamInputActionTable, ESPMode::ThreadSafe> GetActionTable();
+	/// Get the rollback input history of a controller, only available while InputHistoryLength is above 0
+	/// @param ControllerHandle The controller to get the history for
+	/// @return The history, null if the controller is not connected or the history is disabled
+	static const class FSteamInputHistory* GetInputHistory(FInputDeviceId ControllerHandle);
+	/// Get the digital actions a controller held, pressed and released during the last frame, indexed like GetActionTable
+	/// @param ControllerHandle The controller to get the actions for
+	/// @return The actions, null if the controller is not connected
+	static const FSteamInputActionEdges* GetActionEdges(FInputDeviceId ControllerHandle);
+
+	/// Report that an input event was observed, for the SteamInput.Latency measurements. Does nothing while no measurement runs
+	/// @param KeyName Name of the key of the observed event, as dispatched by Steam Input
+	/// @param Path Where the event was observed, EnhancedInput from action bindings and GameCode from anywhere else
+	UFUNCTION(BlueprintCallable, Category = "Steam|Input|Latency")
+	static void ReportInputObserved(FName KeyName, ESteamInputLatencyPath Path);
+
+	/// Get the motion sensor state of a controller. With motion enabled in the settings this is the state of the current frame including
+	/// the rotation integrated over every reading since the previous frame, otherwise the sensors are read right away without any delta
+	/// @param ControllerHandle The controller to read the motion of
+	/// @param OutMotion Receives the motion
+	/// @return false if the controller is not managed by Steam Input
+	UFUNCTION(BlueprintCallable, Category = "Steam|Input|Motion")
+	static bool GetMotion(FInputDeviceId ControllerHandle, FSteamInputMotion& OutMotion);
+
+	/// Play force feedback curves on a controller from the haptics thread, sampled at the configured HapticPlaybackRate
+	/// @param ControllerHandle The controller to play the curves on
+	/// @param LargeMotors Curve for the large or left motor, may be null
+	/// @param SmallMotors Curve for the small or right motor, may be null
+	/// @param TriggerMotors Curve for both trigger motors, may be null
+	/// @param Strength Scale applied to every curve
+	/// @param bLoop Keep playing until StopHaptics is called
+	UFUNCTION(BlueprintCallable, Category = "Steam|Input|Haptics", meta = (AdvancedDisplay = "Strength,bLoop"))
+	static void PlayHapticCurves(FInputDeviceId ControllerHandle, UCurveFloat* LargeMotors, UCurveFloat* SmallMotors, UCurveFloat* TriggerMotors,
+		float Strength = 1.0f, bool bLoop = false);
+	/// Stop the curves playing on a controller, regular force feedback is unaffected
+	/// @param ControllerHandle The controller to stop the curves on
+	UFUNCTION(BlueprintCallable, Category = "Steam|Input|Haptics")
+	static void StopHaptics(FInputDeviceId ControllerHandle);
 private:
 	static TMap<FName, InputActionSetHandle_t> CachedHandles;
 
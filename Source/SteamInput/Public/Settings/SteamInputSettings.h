@@ -17,6 +17,17 @@ enum class EKeyType : uint8
 	MouseInput
 };
 
+UENUM()
+enum class ESteamInputSamplingMode : uint8
+{
+	/** Poll every action once per rendered frame */
+	PerFrame,
+	/** Poll every action on a background thread at SampleRate, every sample is dispatched in order */
+	FixedRate,
+	/** Let Steam report action changes as events whenever it runs a frame, every change is dispatched in order */
+	ActionEvents
+};
+
 UENUM()
 enum class EUINavigationOptions : uint8
 {
@@ -40,6 +51,17 @@ enum class EUINavigationOptions : uint8
 	Invalid,
 };
 
+UENUM()
+enum class ESteamInputGestureStepType : uint8
+{
+	/** Every action of the step is down and one of them was pressed just now, chords press them within Duration of each other */
+	Press,
+	/** One of the actions was released and none of them is down anymore */
+	Release,
+	/** Every action of the step stayed down for Duration */
+	Hold
+};
+
 class UTexture2D;
 
 // Helper struct to handle conversions
@@ -164,6 +186,95 @@ struct FSteamInputAction
 #endif
 };
 
+/** Actions that belong to an action set or layer of the action manifest */
+USTRUCT()
+struct FSteamInputActionSetActions
+{
+	GENERATED_BODY()
+
+	// Name of the action set or layer, as in the action manifest
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Action Set")
+	FName ActionSetName;
+
+	// Actions that can fire while the set is active or the layer is applied
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Action Set", meta = (GetOptions = "SteamInput.SteamInputSettings.GetKeyList"))
+	TArray<FName> Actions;
+};
+
+/** Single step of an FSteamInputGesture */
+USTRUCT()
+struct FSteamInputGestureStep
+{
+	GENERATED_BODY()
+
+	// Digital actions the step looks at, several for chords or diagonals
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Gesture", meta = (GetOptions = "SteamInput.SteamInputSettings.GetKeyList"))
+	TArray<FName> Actions;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Gesture")
+	ESteamInputGestureStepType Type = ESteamInputGestureStepType::Press;
+
+	// Press: longest time between the presses of a chord, 0 accepts any. Hold: how long the actions have to stay down
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Gesture", meta = (ClampMin = "0", Units = "s"))
+	float Duration = 0.0f;
+
+	// Longest time after the previous step, ignored for the first step
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Gesture", meta = (ClampMin = "0", Units = "s"))
+	float MaxDelay = 0.25f;
+};
+
+/** Sequence of steps over the digital actions, dispatched as a key of its own once every step matched in order */
+USTRUCT()
+struct FSteamInputGesture
+{
+	GENERATED_BODY()
+
+	// Name of the key pressed and released when the gesture is recognized
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Gesture")
+	FName GestureName;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Gesture")
+	TArray<FSteamInputGestureStep> Steps;
+};
+
+/** Shaping and smoothing applied to an analog action before it is dispatched */
+USTRUCT()
+struct FSteamInputAnalogFilterSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Filter", meta = (GetOptions = "SteamInput.SteamInputSettings.GetKeyList"))
+	FName ActionName;
+
+	// Deflection below which the action reads 0, radial for joysticks. Dead zones and the response curve are ignored for MouseInput actions
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Filter", meta = (ClampMin = "0", ClampMax = "1"))
+	float DeadZone = 0.0f;
+
+	// Deflection at which the action reads 1
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Filter", meta = (ClampMin = "0", ClampMax = "1"))
+	float OuterDeadZone = 1.0f;
+
+	// Exponent of the response curve between the dead zones, 1 is linear and higher gives more precision near the center
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Filter", meta = (ClampMin = "0.1", ClampMax = "8"))
+	float ResponseExponent = 1.0f;
+
+	// Smooth the action with a one euro filter, which removes jitter at rest and adds little lag during fast motion
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Filter")
+	bool bSmooth = false;
+
+	// Cutoff frequency at rest, lower removes more jitter
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Filter", meta = (EditCondition = "bSmooth", ClampMin = "0.01", Units = "Hz"))
+	float MinCutoff = 1.0f;
+
+	// How fast the cutoff rises with the speed of the action, higher reduces lag during fast motion
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Filter", meta = (EditCondition = "bSmooth", ClampMin = "0"))
+	float Beta = 0.0f;
+
+	// Cutoff frequency of the speed estimate the cutoff follows
+	UPROPERTY(Config, EditAnywhere, Category = "Steam|Input|Filter", meta = (EditCondition = "bSmooth", ClampMin = "0.01", Units = "Hz"))
+	float DerivativeCutoff = 1.0f;
+};
+
 /**
  * 
  */
@@ -214,8 +325,86 @@ public:
 	// Mapping for Steam Input Action Origin to it's texture
 	UPROPERTY(Config, EditAnywhere, Category = "Slate | UI")
 	TMap<ESteamInputActionOrigin, TSoftObjectPtr<UTexture2D>> ButtonTextureMapping;
+
+	// How controller state is sampled, FixedRate decouples input from the render frame rate
+	UPROPERTY(Config, EditAnywhere, Category = "Sampling")
+	ESteamInputSamplingMode SamplingMode = ESteamInputSamplingMode::PerFrame;
+
+	// Rate at which the background sampler polls the controllers
+	UPROPERTY(Config, EditAnywhere, Category = "Sampling",
+			  meta = (EditCondition = "SamplingMode == ESteamInputSamplingMode::FixedRate", ClampMin = "30", ClampMax = "1000", Units = "Hz"))
+	float SampleRate = 120.0f;
+
+	// Amount of samples kept per controller, bounds how far simulation code can look back
+	UPROPERTY(Config, EditAnywhere, Category = "Sampling",
+			  meta = (EditCondition = "SamplingMode == ESteamInputSamplingMode::FixedRate", ClampMin = "8", ClampMax = "4096"))
+	int32 SampleBufferSize = 128;
+
+	// Filters applied to analog, joystick and mouse actions before dispatch, unchanged values are detected on the filtered result
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering")
+	TArray<FSteamInputAnalogFilterSettings> AnalogFilters;
+
+	// Change an analog or joystick axis needs since its last dispatched value to be dispatched again. Reaching 0 or full deflection is always dispatched
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering", meta = (ClampMin = "0", ClampMax = "0.1"))
+	float AnalogChangeThreshold = 0.001f;
+
+	// Actions of every action set and layer, only the actions of the active set and layers get polled. Actions not listed in any set are always polled
+	UPROPERTY(Config, EditAnywhere, Category = "Action Sets")
+	TArray<FSteamInputActionSetActions> ActionSets;
+
+	// Action manifest ImportActionManifest reads the action sets and layers from
+	UPROPERTY(Config, EditAnywhere, Category = "Action Sets", meta = (FilePathFilter = "vdf"))
+	FFilePath ActionManifest;
+
+	// Double taps, holds, chords and motion inputs recognized natively on every sample, each dispatched as its own key
+	UPROPERTY(Config, EditAnywhere, Category = "Gestures")
+	TArray<FSteamInputGesture> Gestures;
+
+	// Read the motion sensors of every controller, dispatched as the engine motion keys and as the Steam_Gyro axes.
+	// Steam refreshes the sensors when it runs a frame, so they are read at SampleRate in the FixedRate sampling mode and once per rendered frame otherwise
+	UPROPERTY(Config, EditAnywhere, Category = "Motion")
+	bool bEnableMotion = false;
+
+	// Turn the game view by the gyro and stick motion sampled after the game thread dispatched the frame, right before the render thread builds it.
+	// Hides up to a frame of aim latency without changing the simulation, needs the FixedRate sampling mode and bEnableMotion for the gyro
+	UPROPERTY(Config, EditAnywhere, Category = "Late Latch")
+	bool bLateLatchCamera = false;
+
+	// Joystick action the game turns the camera with
+	UPROPERTY(Config, EditAnywhere, Category = "Late Latch", meta = (EditCondition = "bLateLatchCamera", GetOptions = "SteamInput.SteamInputSettings.GetKeyList"))
+	FName LateLatchStickAction;
+
+	// Degrees per second the game turns the camera at full deflection of LateLatchStickAction, yaw in X and pitch in Y. Has to match the game for the view to line up
+	UPROPERTY(Config, EditAnywhere, Category = "Late Latch", meta = (EditCondition = "bLateLatchCamera"))
+	FVector2D LateLatchStickRate = FVector2D::ZeroVector;
+
+	// Degrees the game turns the camera per degree reported on the Steam_Gyro axes, yaw in X and pitch in Y
+	UPROPERTY(Config, EditAnywhere, Category = "Late Latch", meta = (EditCondition = "bLateLatchCamera"))
+	FVector2D LateLatchGyroSensitivity = FVector2D::UnitVector;
+
+	// Amount of dispatched ticks kept per controller as quantized frames for rollback, 0 disables the history
+	UPROPERTY(Config, EditAnywhere, Category = "Rollback", meta = (ClampMin = "0", ClampMax = "4096"))
+	int32 InputHistoryLength = 0;
+
+	// Bits analog and joystick axes are quantized to in FSteamInputSnapshot, MouseInput deltas always keep their full precision
+	UPROPERTY(Config, EditAnywhere, Category = "Rollback", meta = (ClampMin = "4", ClampMax = "16"))
+	int32 SnapshotAxisPrecision = 10;
+
+	// Rate at which haptic envelopes are evaluated and sent on the haptics thread, independent of the frame rate
+	UPROPERTY(Config, EditAnywhere, Category = "Haptics", meta = (ClampMin = "30", ClampMax = "1000", Units = "Hz"))
+	float HapticPlaybackRate = 250.0f;
+
+	// Seconds of dispatched input kept in memory and dumped on crashes, ensures and SteamInput.FlightRecorder, 0 disables the flight recorder
+	UPROPERTY(Config, EditAnywhere, Category = "Diagnostics", meta = (ClampMin = "0", ClampMax = "300", Units = "s"))
+	float FlightRecorderSeconds = 10.0f;
+
+	// Amount of samples the flight recorder preallocates, shared by all controllers. Bounds how much of FlightRecorderSeconds survives at high sample rates
+	UPROPERTY(Config, EditAnywhere, Category = "Diagnostics", meta = (EditCondition = "FlightRecorderSeconds > 0", ClampMin = "256", ClampMax = "65536"))
+	int32 FlightRecorderCapacity = 4096;
 	
 	static const FName MenuCategory;
+	/** 2D key carrying the gyro rotation since the previous frame in degrees, yaw in X and pitch in Y */
+	static const FName GyroKeyName;
 	
 	static FName GetXAxisName(const FName Name);
 
@@ -226,6 +415,9 @@ public:
 	
 	void RefreshHandles();
 
+	/** Incremented every time the action handles get regenerated, anything derived from Keys should rebuild when this changes */
+	uint32 GetHandleRevision() const {return HandleRevision;}
+
 	void UpdateSlateNavigationConfig();
 	void SetupDefaultSlateBindings();
 private:
@@ -238,6 +430,10 @@ private:
 #if WITH_EDITOR
 	virtual void PostEditChangeChainProperty(struct FPropertyChangedChainEvent& PropertyChangedEvent) override;
 
+	/** Replace ActionSets with the sets and layers declared in the ActionManifest file */
+	UFUNCTION(CallInEditor, Category = "Action Sets")
+	void ImportActionManifest();
+
 	UFUNCTION(CallInEditor, Category = "Debug")
 	void ValidateSlateIntegration();
 	UFUNCTION(CallInEditor, Category = "Debug")
@@ -245,4 +441,6 @@ private:
 #endif
 	UPROPERTY(VisibleAnywhere, Category = "Debug")
 	int AppID;
+
+	uint32 HandleRevision = 0;
 };
@@ -10,6 +10,8 @@ DECLARE_MULTICAST_DELEGATE(SteamInputInitialized);
 class FSteamInputModule : public IInputDeviceModule
 {
 public:
+    virtual ~FSteamInputModule() override;
+
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
 
@@ -21,6 +23,9 @@ public:
     bool BindToOnInputInitialized(const SteamInputInitialized::FDelegate& InNewDelegate);
     
     virtual TSharedPtr<class IInputDevice> CreateInputDevice(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler) override;
+
+    /** The input device created for this module, null until the engine created its input devices or when Steam Input is unavailable */
+    TSharedPtr<class FSteamInputController> GetInputController() const {return Controller;}
 private:
     bool bSteamInputInitialized = false;
 
@@ -29,5 +34,15 @@ private:
     TSharedPtr<class FSteamInputController> Controller = nullptr;
     TSharedPtr<class FSteamClientInstanceHandler> ClientHandle = nullptr;
 
+    /** SteamInput.Latency console command, not available in shipping builds */
+    TUniquePtr<class FSteamInputLatencyHarness> LatencyHarness;
+    /** SteamInput.Record, SteamInput.Replay and SteamInput.FlightRecorder console commands */
+    struct IConsoleCommand* RecordCommand = nullptr;
+    struct IConsoleCommand* ReplayCommand = nullptr;
+    struct IConsoleCommand* FlightRecorderCommand = nullptr;
+
     void InitializeSlateIntegration() const;
+    void HandleRecordCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) const;
+    void HandleReplayCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) const;
+    void HandleFlightRecorderCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) const;
 };
@@ -577,3 +577,33 @@ struct FSteamKey
 	FSteamKey(const FName Key) : Key(Key) {}
 	operator FName() const {return Key;}
 };
+
+/// @brief Motion sensor state of a controller, as of the last dispatched frame
+USTRUCT(BlueprintType)
+struct FSteamInputMotion
+{
+	GENERATED_BODY()
+
+	/** Absolute orientation since the controller woke up, real world up is known but the heading is not */
+	UPROPERTY(BlueprintReadOnly, Category = "Steam|Input|Motion")
+	FQuat Orientation = FQuat::Identity;
+
+	/** Angular velocity of the newest sensor reading in degrees per second, X is pitch, Y is roll and Z is yaw */
+	UPROPERTY(BlueprintReadOnly, Category = "Steam|Input|Motion")
+	FVector RotationRate = FVector::ZeroVector;
+
+	/** Acceleration of the newest sensor reading in G */
+	UPROPERTY(BlueprintReadOnly, Category = "Steam|Input|Motion")
+	FVector Acceleration = FVector::ZeroVector;
+
+	/** Rotation in degrees integrated over every sensor reading since the previous frame, X is pitch, Y is roll and Z is yaw */
+	UPROPERTY(BlueprintReadOnly, Category = "Steam|Input|Motion")
+	FVector RotationDelta = FVector::ZeroVector;
+
+	/** Amount of sensor readings integrated into RotationDelta */
+	UPROPERTY(BlueprintReadOnly, Category = "Steam|Input|Motion")
+	int32 NumReadings = 0;
+
+	/** FPlatformTime::Seconds() of the newest reading */
+	double Timestamp = 0.0;
+};
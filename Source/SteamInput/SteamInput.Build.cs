@@ -28,6 +28,8 @@ public class SteamInput : ModuleRules
                 "ApplicationCore",
                 "Slate",
                 "SlateCore",
+                "RHI",
+                "RenderCore",
                 "SteamShared"
             }
         );